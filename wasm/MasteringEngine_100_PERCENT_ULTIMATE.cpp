@@ -22,1708 +22,174 @@
  *
  * Rivals: Sterling Sound, Abbey Road Studios, FabFilter, iZotope Ozone 11
  * Status: 100% PRODUCTION-READY, WORLD-CLASS
+ *
+ * This file is the thin embind adapter. The DSP itself lives in dsp/ with no
+ * Emscripten dependency and is shared with the native build (CMakeLists.txt).
  */
 
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
-#include <cmath>
-#include <vector>
-#include <algorithm>
+
 #include <array>
-#include <random>
 #include <string>
 
-using namespace emscripten;
-
-// ═══════════════════════════════════════════════════════════════════════════
-// CONSTANTS
-// ═══════════════════════════════════════════════════════════════════════════
-
-constexpr double PI = 3.14159265358979323846;
-constexpr double SQRT2 = 1.41421356237309504880;
-constexpr int OVERSAMPLING_FACTOR = 4;
-constexpr int LOOKAHEAD_SAMPLES = 2400; // 50ms @ 48kHz
-constexpr int FIR_TAP_COUNT = 64;
-
-// ═══════════════════════════════════════════════════════════════════════════
-// UTILITY FUNCTIONS
-// ═══════════════════════════════════════════════════════════════════════════
-
-inline double dbToLinear(double db) {
-    return std::pow(10.0, db / 20.0);
-}
-
-inline double linearToDb(double linear) {
-    return 20.0 * std::log10(std::max(linear, 1e-10));
-}
-
-inline double fastTanh(double x) {
-    if (x < -3.0) return -1.0;
-    if (x > 3.0) return 1.0;
-    return x * (27.0 + x * x) / (27.0 + 9.0 * x * x);
-}
-
-// Hard-clip function for "Safe-Clip" mode
-inline double hardClip(double x, double ceiling) {
-    if (x > ceiling) return ceiling;
-    if (x < -ceiling) return -ceiling;
-    return x;
-}
-
-// ═══════════════════════════════════════════════════════════════════════════
-// PARAMETER SMOOTHER (Prevents Zipper Noise)
-// ═══════════════════════════════════════════════════════════════════════════
-
-class ParameterSmoother {
-private:
-    double target = 0.0;
-    double current = 0.0;
-    double smoothCoeff = 0.0;
-
-public:
-    ParameterSmoother(double smoothTimeMs = 20.0, double sampleRate = 48000.0) {
-        setSmoothTime(smoothTimeMs, sampleRate);
-    }
-
-    void setSmoothTime(double smoothTimeMs, double sampleRate) {
-        smoothCoeff = std::exp(-1.0 / (smoothTimeMs * 0.001 * sampleRate));
-    }
-
-    void setTarget(double newValue) {
-        target = newValue;
-    }
-
-    void setImmediate(double newValue) {
-        target = newValue;
-        current = newValue;
-    }
-
-    inline double getSmoothed() {
-        current = target + smoothCoeff * (current - target);
-        return current;
-    }
-
-    void reset() {
-        current = target;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// DC OFFSET FILTER (Essential for Clean Headroom)
-// ═══════════════════════════════════════════════════════════════════════════
-
-class DCOffsetFilter {
-private:
-    double state = 0.0;
-    constexpr static double COEFF = 0.999;  // ~1Hz highpass
-    bool enabled = true;
-
-public:
-    void setEnabled(bool enable) {
-        enabled = enable;
-    }
-
-    inline double process(double input) {
-        if (!enabled) return input;
-
-        // First-order highpass filter @ ~1Hz
-        double output = input - state;
-        state = state * COEFF + input * (1.0 - COEFF);
-        return output;
-    }
-
-    void reset() {
-        state = 0.0;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// ZDF BIQUAD FILTER (Zero-Delay Feedback with Nyquist De-cramping)
-// ═══════════════════════════════════════════════════════════════════════════
-
-class ZDFBiquad {
-private:
-    double g;
-    double k;
-    double a1, a2, a3;
-    double m0, m1, m2;
-    double ic1eq = 0.0;
-    double ic2eq = 0.0;
-    double sampleRate;
-
-public:
-    enum FilterType {
-        LOWPASS,
-        HIGHPASS,
-        BANDPASS,
-        BELL,
-        LOWSHELF,
-        HIGHSHELF,
-        NOTCH
-    };
-
-    ZDFBiquad() : sampleRate(48000.0) {
-        setCoefficients(1000.0, 0.707, 0.0, BELL);
-    }
-
-    void setSampleRate(double sr) {
-        sampleRate = sr;
-    }
-
-    void setCoefficients(double freq, double Q, double gainDB, FilterType type) {
-        g = std::tan(PI * freq / sampleRate);
-        k = 1.0 / Q;
-        double A = dbToLinear(gainDB);
-
-        switch (type) {
-            case LOWPASS:
-                a1 = 1.0 / (1.0 + g * (g + k));
-                a2 = g * a1;
-                a3 = g * a2;
-                m0 = 0.0;
-                m1 = 0.0;
-                m2 = 1.0;
-                break;
-
-            case HIGHPASS:
-                a1 = 1.0 / (1.0 + g * (g + k));
-                a2 = g * a1;
-                a3 = g * a2;
-                m0 = 1.0;
-                m1 = -k;
-                m2 = -1.0;
-                break;
-
-            case BANDPASS:
-                a1 = 1.0 / (1.0 + g * (g + k));
-                a2 = g * a1;
-                a3 = g * a2;
-                m0 = 0.0;
-                m1 = 1.0;
-                m2 = 0.0;
-                break;
-
-            case BELL: {
-                double A2 = A * A;
-                a1 = 1.0 / (1.0 + g * (g + k));
-                a2 = g * a1;
-                a3 = g * a2;
-                m0 = 1.0;
-                m1 = k * (A2 - 1.0);
-                m2 = 0.0;
-                break;
-            }
-
-            case LOWSHELF: {
-                double A2 = A * A;
-                a1 = 1.0 / (1.0 + g * (g + k));
-                a2 = g * a1;
-                a3 = g * a2;
-                m0 = 1.0;
-                m1 = k * (A - 1.0);
-                m2 = A2 - 1.0;
-                break;
-            }
-
-            case HIGHSHELF: {
-                double A2 = A * A;
-                a1 = 1.0 / (1.0 + g * (g + k));
-                a2 = g * a1;
-                a3 = g * a2;
-                m0 = A2;
-                m1 = k * (1.0 - A) * A;
-                m2 = 1.0 - A2;
-                break;
-            }
-
-            case NOTCH:
-                a1 = 1.0 / (1.0 + g * (g + k));
-                a2 = g * a1;
-                a3 = g * a2;
-                m0 = 1.0;
-                m1 = -k;
-                m2 = 0.0;
-                break;
-        }
-    }
-
-    inline double process(double input) {
-        double v3 = input - ic2eq;
-        double v1 = a1 * ic1eq + a2 * v3;
-        double v2 = ic2eq + a2 * ic1eq + a3 * v3;
-        ic1eq = 2.0 * v1 - ic1eq;
-        ic2eq = 2.0 * v2 - ic2eq;
-        return m0 * input + m1 * v1 + m2 * v2;
-    }
-
-    void reset() {
-        ic1eq = 0.0;
-        ic2eq = 0.0;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// 7-BAND PARAMETRIC EQ (Professional Mastering Grade)
-// ═══════════════════════════════════════════════════════════════════════════
-
-class SevenBandEQ {
-private:
-    std::array<ZDFBiquad, 7> filters;
-    std::array<ParameterSmoother, 7> gainSmoothers;
-
-    const std::array<double, 7> centerFreqs = {
-        40.0, 120.0, 350.0, 1000.0, 3500.0, 8000.0, 14000.0
-    };
-
-public:
-    SevenBandEQ() {
-        for (int i = 0; i < 7; ++i) {
-            filters[i].setCoefficients(centerFreqs[i], 0.707, 0.0, ZDFBiquad::BELL);
-        }
-    }
-
-    void setSampleRate(double sr) {
-        for (auto& filter : filters) {
-            filter.setSampleRate(sr);
-        }
-        for (auto& smoother : gainSmoothers) {
-            smoother.setSmoothTime(20.0, sr);
-        }
-    }
-
-    void setBandGain(int band, double gainDB) {
-        if (band >= 0 && band < 7) {
-            gainSmoothers[band].setTarget(gainDB);
-        }
-    }
-
-    void setAllGains(const std::array<double, 7>& gains) {
-        for (int i = 0; i < 7; ++i) {
-            setBandGain(i, gains[i]);
-        }
-    }
-
-    inline double process(double input) {
-        double output = input;
-        for (int i = 0; i < 7; ++i) {
-            double smoothedGain = gainSmoothers[i].getSmoothed();
-            filters[i].setCoefficients(centerFreqs[i], 0.707, smoothedGain, ZDFBiquad::BELL);
-            output = filters[i].process(output);
-        }
-        return output;
-    }
-
-    void reset() {
-        for (auto& filter : filters) {
-            filter.reset();
-        }
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// HIGH-FREQUENCY AIR PROTECTION
-// ═══════════════════════════════════════════════════════════════════════════
-// Prevents harsh square waves when users aggressively boost the 14kHz "Air" band
-// Uses soft clipping on high frequencies (12-20kHz) before saturation stage
-
-class HighFrequencyProtection {
-private:
-    ZDFBiquad hpFilter;        // Highpass @ 12kHz to isolate air frequencies
-    ZDFBiquad lpFilter;        // Lowpass @ 12kHz for low/mid frequencies
-    double threshold;          // Soft clip threshold (linear)
-    bool enabled;
-
-    // Fast tanh approximation for soft clipping
-    inline double fastTanh(double x) {
-        if (x > 3.0) return 1.0;
-        if (x < -3.0) return -1.0;
-        double x2 = x * x;
-        return x * (27.0 + x2) / (27.0 + 9.0 * x2);
-    }
-
-public:
-    HighFrequencyProtection() : threshold(0.9), enabled(true) {
-        hpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFBiquad::HIGHPASS);
-        lpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFBiquad::LOWPASS);
-    }
-
-    void setSampleRate(double sr) {
-        hpFilter.setSampleRate(sr);
-        lpFilter.setSampleRate(sr);
-        hpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFBiquad::HIGHPASS);
-        lpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFBiquad::LOWPASS);
-    }
-
-    void setEnabled(bool en) {
-        enabled = en;
-    }
-
-    void setThreshold(double thresholdLinear) {
-        threshold = std::max(0.5, std::min(1.0, thresholdLinear));
-    }
-
-    inline double process(double input) {
-        if (!enabled) return input;
-
-        // Split into high and low/mid frequencies
-        double highFreq = hpFilter.process(input);
-        double lowMid = lpFilter.process(input);
-
-        // Apply gentle soft clipping to high frequencies only
-        double clipped = fastTanh(highFreq / threshold) * threshold;
-
-        // Recombine
-        return lowMid + clipped;
-    }
-
-    void reset() {
-        hpFilter.reset();
-        lpFilter.reset();
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// INTELLIGENT DE-ESSER / HIGH-FREQUENCY LIMITER
-// ═══════════════════════════════════════════════════════════════════════════
-// Tames sibilance and harshness in the 8-12kHz range
-// Professional mastering essential for tracks with boosted highs
-
-class DeEsser {
-private:
-    ZDFBiquad sibilanceDetector;  // Bandpass @ 8-12kHz
-    double threshold;              // dB
-    double ratio;
-    double attackCoeff;
-    double releaseCoeff;
-    double envelope;
-    bool enabled;
-
-public:
-    DeEsser() : threshold(-20.0), ratio(4.0), envelope(1.0), enabled(false) {
-        // Bandpass filter centered at 10kHz for sibilance detection
-        sibilanceDetector.setCoefficients(10000.0, 2.0, 0.0, ZDFBiquad::BANDPASS);
-        setAttack(0.001);   // 1ms attack (very fast)
-        setRelease(0.02);   // 20ms release
-    }
-
-    void setSampleRate(double sr) {
-        sibilanceDetector.setSampleRate(sr);
-        setAttack(0.001, sr);
-        setRelease(0.02, sr);
-    }
-
-    void setEnabled(bool enable) {
-        enabled = enable;
-    }
-
-    void setThreshold(double thresholdDB) {
-        threshold = thresholdDB;
-    }
-
-    void setRatio(double r) {
-        ratio = std::max(1.0, std::min(10.0, r));
-    }
-
-    void setAttack(double attackSec, double sampleRate = 48000.0) {
-        attackCoeff = std::exp(-1.0 / (attackSec * sampleRate));
-    }
-
-    void setRelease(double releaseSec, double sampleRate = 48000.0) {
-        releaseCoeff = std::exp(-1.0 / (releaseSec * sampleRate));
-    }
-
-    inline double process(double input) {
-        if (!enabled) return input;
-
-        // Detect sibilance energy
-        double sibilanceSignal = sibilanceDetector.process(input);
-        double sibilanceLevel = std::abs(sibilanceSignal);
-        double sibilanceDB = linearToDb(sibilanceLevel);
-
-        // Calculate gain reduction (only on sibilance)
-        double gainReductionDB = 0.0;
-        if (sibilanceDB > threshold) {
-            gainReductionDB = (sibilanceDB - threshold) * (1.0 - 1.0 / ratio);
-        }
-
-        double targetGain = dbToLinear(-gainReductionDB);
-
-        // Envelope follower
-        double coeff = (targetGain < envelope) ? attackCoeff : releaseCoeff;
-        envelope = targetGain + coeff * (envelope - targetGain);
-
-        // Apply gain reduction to entire signal
-        return input * envelope;
-    }
-
-    double getGainReduction() {
-        return linearToDb(envelope);
-    }
-
-    void reset() {
-        sibilanceDetector.reset();
-        envelope = 1.0;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// LINKWITZ-RILEY 4TH-ORDER CROSSOVER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class LinkwitzRileyCrossover {
-private:
-    ZDFBiquad lowpass1, lowpass2;
-    ZDFBiquad highpass1, highpass2;
-    double crossoverFreq;
-    double sampleRate;
-
-public:
-    LinkwitzRileyCrossover(double freq = 500.0, double sr = 48000.0)
-        : crossoverFreq(freq), sampleRate(sr) {
-        updateCoefficients();
-    }
-
-    void setSampleRate(double sr) {
-        sampleRate = sr;
-        updateCoefficients();
-    }
-
-    void setCrossoverFrequency(double freq) {
-        crossoverFreq = freq;
-        updateCoefficients();
-    }
-
-    void updateCoefficients() {
-        double Q = 0.707;
-        lowpass1.setCoefficients(crossoverFreq, Q, 0.0, ZDFBiquad::LOWPASS);
-        lowpass2.setCoefficients(crossoverFreq, Q, 0.0, ZDFBiquad::LOWPASS);
-        highpass1.setCoefficients(crossoverFreq, Q, 0.0, ZDFBiquad::HIGHPASS);
-        highpass2.setCoefficients(crossoverFreq, Q, 0.0, ZDFBiquad::HIGHPASS);
-    }
-
-    void process(double input, double& low, double& high) {
-        low = lowpass2.process(lowpass1.process(input));
-        high = highpass2.process(highpass1.process(input));
-    }
-
-    void reset() {
-        lowpass1.reset(); lowpass2.reset();
-        highpass1.reset(); highpass2.reset();
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// 3-BAND LINKWITZ-RILEY CROSSOVER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class ThreeBandCrossover {
-private:
-    LinkwitzRileyCrossover lowMidCrossover;
-    LinkwitzRileyCrossover midHighCrossover;
-
-public:
-    ThreeBandCrossover(double lowMid = 250.0, double midHigh = 2000.0, double sr = 48000.0)
-        : lowMidCrossover(lowMid, sr), midHighCrossover(midHigh, sr) {}
-
-    void setSampleRate(double sr) {
-        lowMidCrossover.setSampleRate(sr);
-        midHighCrossover.setSampleRate(sr);
-    }
-
-    void setFrequencies(double lowMid, double midHigh) {
-        lowMidCrossover.setCrossoverFrequency(lowMid);
-        midHighCrossover.setCrossoverFrequency(midHigh);
-    }
-
-    void process(double input, double& low, double& mid, double& high) {
-        double midHigh;
-        lowMidCrossover.process(input, low, midHigh);
-        midHighCrossover.process(midHigh, mid, high);
-    }
-
-    void reset() {
-        lowMidCrossover.reset();
-        midHighCrossover.reset();
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// MULTIBAND COMPRESSOR
-// ═══════════════════════════════════════════════════════════════════════════
-
-class MultibandCompressor {
-private:
-    ThreeBandCrossover crossoverL, crossoverR;
-
-    struct BandCompressor {
-        double threshold;
-        double ratio;
-        double attackCoeff;
-        double releaseCoeff;
-        double envelope;
-
-        BandCompressor() : threshold(-20.0), ratio(4.0), envelope(0.0) {
-            setAttack(0.01);
-            setRelease(0.1);
-        }
-
-        void setAttack(double attackSec, double sampleRate = 48000.0) {
-            attackCoeff = std::exp(-1.0 / (attackSec * sampleRate));
-        }
-
-        void setRelease(double releaseSec, double sampleRate = 48000.0) {
-            releaseCoeff = std::exp(-1.0 / (releaseSec * sampleRate));
-        }
-
-        inline double process(double input) {
-            double inputLevel = std::abs(input);
-            double inputDB = linearToDb(inputLevel);
-            double gainReductionDB = 0.0;
-            if (inputDB > threshold) {
-                gainReductionDB = (inputDB - threshold) * (1.0 - 1.0 / ratio);
-            }
-            double targetGain = dbToLinear(-gainReductionDB);
-            double coeff = (targetGain < envelope) ? attackCoeff : releaseCoeff;
-            envelope = targetGain + coeff * (envelope - targetGain);
-            return input * envelope;
-        }
-    };
-
-    BandCompressor lowComp, midComp, highComp;
-    bool enabled;
-
-public:
-    MultibandCompressor() : enabled(false) {}
-
-    void setSampleRate(double sr) {
-        crossoverL.setSampleRate(sr);
-        crossoverR.setSampleRate(sr);
-        lowComp.setAttack(0.01, sr);
-        lowComp.setRelease(0.1, sr);
-        midComp.setAttack(0.005, sr);
-        midComp.setRelease(0.08, sr);
-        highComp.setAttack(0.003, sr);
-        highComp.setRelease(0.05, sr);
-    }
-
-    void setEnabled(bool enable) {
-        enabled = enable;
-    }
-
-    void setLowBand(double threshold, double ratio) {
-        lowComp.threshold = threshold;
-        lowComp.ratio = ratio;
-    }
-
-    void setMidBand(double threshold, double ratio) {
-        midComp.threshold = threshold;
-        midComp.ratio = ratio;
-    }
-
-    void setHighBand(double threshold, double ratio) {
-        highComp.threshold = threshold;
-        highComp.ratio = ratio;
-    }
-
-    void processStereo(double& left, double& right) {
-        if (!enabled) return;
-
-        double lowL, midL, highL, lowR, midR, highR;
-        crossoverL.process(left, lowL, midL, highL);
-        crossoverR.process(right, lowR, midR, highR);
-
-        lowL = lowComp.process(lowL);
-        lowR = lowComp.process(lowR);
-        midL = midComp.process(midL);
-        midR = midComp.process(midR);
-        highL = highComp.process(highL);
-        highR = highComp.process(highR);
-
-        left = lowL + midL + highL;
-        right = lowR + midR + highR;
-    }
-
-    void reset() {
-        crossoverL.reset();
-        crossoverR.reset();
-        lowComp.envelope = 0.0;
-        midComp.envelope = 0.0;
-        highComp.envelope = 0.0;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// MID-SIDE (M/S) PROCESSOR
-// ═══════════════════════════════════════════════════════════════════════════
-
-class MidSideProcessor {
-public:
-    static inline void encode(double L, double R, double& M, double& S) {
-        M = (L + R) * 0.5;
-        S = (L - R) * 0.5;
-    }
-
-    static inline void decode(double M, double S, double& L, double& R) {
-        L = M + S;
-        R = M - S;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// FREQUENCY-DEPENDENT STEREO WIDENER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class StereoImager {
-private:
-    ThreeBandCrossover crossoverL, crossoverR;
-    double widthAmount = 1.0;
-    ParameterSmoother widthSmoother;
-
-public:
-    StereoImager() {
-        widthSmoother.setImmediate(1.0);
-    }
-
-    void setSampleRate(double sr) {
-        crossoverL.setSampleRate(sr);
-        crossoverR.setSampleRate(sr);
-        widthSmoother.setSmoothTime(50.0, sr);
-    }
-
-    void setWidth(double width) {
-        widthAmount = std::max(0.0, std::min(2.0, width));
-        widthSmoother.setTarget(widthAmount);
-    }
-
-    void processStereo(double& L, double& R) {
-        double width = widthSmoother.getSmoothed();
-
-        double lowL, midL, highL, lowR, midR, highR;
-        crossoverL.process(L, lowL, midL, highL);
-        crossoverR.process(R, lowR, midR, highR);
-
-        // LOW: 100% MONO
-        double lowMono = (lowL + lowR) * 0.5;
-        lowL = lowR = lowMono;
-
-        // MID: 50% of width
-        double midM, midS;
-        MidSideProcessor::encode(midL, midR, midM, midS);
-        midS *= (0.5 * width);
-        MidSideProcessor::decode(midM, midS, midL, midR);
-
-        // HIGH: 100% of width
-        double highM, highS;
-        MidSideProcessor::encode(highL, highR, highM, highS);
-        highS *= width;
-        MidSideProcessor::decode(highM, highS, highL, highR);
-
-        L = lowL + midL + highL;
-        R = lowR + midR + highR;
-    }
-
-    void reset() {
-        crossoverL.reset();
-        crossoverR.reset();
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// ANALOG SATURATION / SOFT CLIPPER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class AnalogSaturation {
-private:
-    double drive = 1.0;
-    double mix = 0.5;
-    ParameterSmoother driveSmoother;
-    ParameterSmoother mixSmoother;
-    double dcBlockerState = 0.0;
-    constexpr static double DC_COEFF = 0.995;
-
-public:
-    AnalogSaturation() {
-        driveSmoother.setImmediate(1.0);
-        mixSmoother.setImmediate(0.5);
-    }
-
-    void setSampleRate(double sr) {
-        driveSmoother.setSmoothTime(20.0, sr);
-        mixSmoother.setSmoothTime(20.0, sr);
-    }
-
-    void setDrive(double driveAmount) {
-        drive = std::max(1.0, std::min(4.0, driveAmount));
-        driveSmoother.setTarget(drive);
-    }
-
-    void setMix(double mixAmount) {
-        mix = std::max(0.0, std::min(1.0, mixAmount));
-        mixSmoother.setTarget(mix);
-    }
-
-    inline double process(double input) {
-        double smoothDrive = driveSmoother.getSmoothed();
-        double smoothMix = mixSmoother.getSmoothed();
-        double driven = input * smoothDrive;
-        double saturated = fastTanh(driven) / smoothDrive;
-        double blocked = saturated - dcBlockerState;
-        dcBlockerState = dcBlockerState * DC_COEFF + saturated * (1.0 - DC_COEFF);
-        return input * (1.0 - smoothMix) + blocked * smoothMix;
-    }
-
-    void reset() {
-        dcBlockerState = 0.0;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// POLYPHASE FIR OVERSAMPLER (4x)
-// ═══════════════════════════════════════════════════════════════════════════
-
-class Oversampler {
-private:
-    std::array<double, FIR_TAP_COUNT> firCoeffs;
-    std::array<double, FIR_TAP_COUNT> upsampleHistory;
-    std::array<double, FIR_TAP_COUNT> downsampleHistory;
-    int historyIndex = 0;
-
-    void generateFIRCoeffs() {
-        double cutoff = 0.25;
-        for (int i = 0; i < FIR_TAP_COUNT; ++i) {
-            int n = i - FIR_TAP_COUNT / 2;
-            double sinc = (n == 0) ? 1.0 : std::sin(PI * cutoff * n) / (PI * cutoff * n);
-            double window = 0.42 - 0.5 * std::cos(2.0 * PI * i / (FIR_TAP_COUNT - 1))
-                          + 0.08 * std::cos(4.0 * PI * i / (FIR_TAP_COUNT - 1));
-            firCoeffs[i] = sinc * window * cutoff;
-        }
-    }
-
-public:
-    Oversampler() {
-        generateFIRCoeffs();
-        upsampleHistory.fill(0.0);
-        downsampleHistory.fill(0.0);
-    }
-
-    std::array<double, 4> upsample(double input) {
-        std::array<double, 4> output;
-        upsampleHistory[historyIndex] = input * OVERSAMPLING_FACTOR;
-
-        for (int phase = 0; phase < OVERSAMPLING_FACTOR; ++phase) {
-            double sum = 0.0;
-            for (int i = 0; i < FIR_TAP_COUNT; ++i) {
-                int idx = (historyIndex - i + FIR_TAP_COUNT) % FIR_TAP_COUNT;
-                sum += upsampleHistory[idx] * firCoeffs[i];
-            }
-            output[phase] = sum;
-        }
-
-        historyIndex = (historyIndex + 1) % FIR_TAP_COUNT;
-        return output;
-    }
-
-    double downsample(const std::array<double, 4>& input) {
-        double sum = 0.0;
-        for (int i = 0; i < OVERSAMPLING_FACTOR; ++i) {
-            downsampleHistory[historyIndex] = input[i];
-            historyIndex = (historyIndex + 1) % FIR_TAP_COUNT;
-        }
-        for (int i = 0; i < FIR_TAP_COUNT; i += OVERSAMPLING_FACTOR) {
-            int idx = (historyIndex - i + FIR_TAP_COUNT) % FIR_TAP_COUNT;
-            sum += downsampleHistory[idx] * firCoeffs[i];
-        }
-        return sum;
-    }
-
-    void reset() {
-        upsampleHistory.fill(0.0);
-        downsampleHistory.fill(0.0);
-        historyIndex = 0;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// TRUE-PEAK LIMITER with SAFE-CLIP MODE
-// ═══════════════════════════════════════════════════════════════════════════
-
-class TruePeakLimiter {
-private:
-    double threshold;
-    double thresholdLinear;
-    double release;
-    double releaseCoeff;
-    std::vector<double> lookAheadBuffer;
-    int lookAheadIndex = 0;
-    int lookAheadSize;
-    double envelope = 0.0;
-    double sampleRate;
-    Oversampler oversamplerL;
-    Oversampler oversamplerR;
-
-    // SAFE-CLIP MODE
-    bool safeClipMode = false;  // false = transparent limiting, true = aggressive clipping
-
-public:
-    TruePeakLimiter(double sr = 48000.0) : sampleRate(sr) {
-        lookAheadSize = LOOKAHEAD_SAMPLES;
-        lookAheadBuffer.resize(lookAheadSize * 2, 0.0);
-        setThreshold(-1.0);
-        setRelease(0.05);
-    }
-
-    void setSampleRate(double sr) {
-        sampleRate = sr;
-        lookAheadSize = static_cast<int>(0.05 * sampleRate);
-        lookAheadBuffer.resize(lookAheadSize * 2, 0.0);
-        setRelease(release);
-    }
-
-    void setThreshold(double thresholdDB) {
-        threshold = thresholdDB;
-        thresholdLinear = dbToLinear(thresholdDB);
-    }
-
-    void setRelease(double releaseSec) {
-        release = releaseSec;
-        releaseCoeff = std::exp(-1.0 / (release * sampleRate));
-    }
-
-    void setSafeClipMode(bool enabled) {
-        safeClipMode = enabled;
-    }
-
-    void processStereo(double& left, double& right) {
-        auto leftUp = oversamplerL.upsample(left);
-        auto rightUp = oversamplerR.upsample(right);
-
-        double truePeak = 0.0;
-        for (int i = 0; i < OVERSAMPLING_FACTOR; ++i) {
-            double peakL = std::abs(leftUp[i]);
-            double peakR = std::abs(rightUp[i]);
-            truePeak = std::max(truePeak, std::max(peakL, peakR));
-        }
-
-        double targetGain = (truePeak > thresholdLinear) ? (thresholdLinear / truePeak) : 1.0;
-        envelope = std::min(targetGain, envelope * releaseCoeff + targetGain * (1.0 - releaseCoeff));
-
-        std::array<double, 4> leftLimited;
-        std::array<double, 4> rightLimited;
-
-        if (safeClipMode) {
-            // SAFE-CLIP MODE: Aggressive hard-clipping (Loudness War style)
-            for (int i = 0; i < OVERSAMPLING_FACTOR; ++i) {
-                leftLimited[i] = hardClip(leftUp[i], thresholdLinear);
-                rightLimited[i] = hardClip(rightUp[i], thresholdLinear);
-            }
-        } else {
-            // TRANSPARENT MODE: Soft limiting
-            for (int i = 0; i < OVERSAMPLING_FACTOR; ++i) {
-                leftLimited[i] = leftUp[i] * envelope;
-                rightLimited[i] = rightUp[i] * envelope;
-            }
-        }
-
-        left = oversamplerL.downsample(leftLimited);
-        right = oversamplerR.downsample(rightLimited);
-
-        lookAheadBuffer[lookAheadIndex * 2] = left;
-        lookAheadBuffer[lookAheadIndex * 2 + 1] = right;
-
-        int readIndex = (lookAheadIndex + 1) % lookAheadSize;
-        left = lookAheadBuffer[readIndex * 2];
-        right = lookAheadBuffer[readIndex * 2 + 1];
-
-        lookAheadIndex = (lookAheadIndex + 1) % lookAheadSize;
-    }
-
-    double getGainReduction() {
-        return linearToDb(envelope);
-    }
-
-    void reset() {
-        std::fill(lookAheadBuffer.begin(), lookAheadBuffer.end(), 0.0);
-        lookAheadIndex = 0;
-        envelope = 0.0;
-        oversamplerL.reset();
-        oversamplerR.reset();
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// DITHERING (TPDF)
-// ═══════════════════════════════════════════════════════════════════════════
-
-class Dithering {
-private:
-    std::mt19937 rng;
-    std::uniform_real_distribution<double> dist;
-    int targetBits = 16;
-    bool enabled = false;
-
-public:
-    Dithering() : dist(-1.0, 1.0) {
-        rng.seed(12345);
-    }
-
-    void setEnabled(bool enable) {
-        enabled = enable;
-    }
-
-    void setTargetBits(int bits) {
-        targetBits = std::max(8, std::min(24, bits));
-    }
-
-    inline double process(double input) {
-        if (!enabled) return input;
-
-        double dither1 = dist(rng);
-        double dither2 = dist(rng);
-        double tpdfDither = (dither1 + dither2) * 0.5;
-
-        double lsb = 1.0 / std::pow(2.0, targetBits - 1);
-        double dithered = input + tpdfDither * lsb;
-
-        double quantized = std::round(dithered * std::pow(2.0, targetBits - 1)) /
-                          std::pow(2.0, targetBits - 1);
-
-        return quantized;
-    }
-
-    void reset() {
-        rng.seed(12345);
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// SAMPLE RATE CONVERTER (High-Quality Sinc Interpolation)
-// ═══════════════════════════════════════════════════════════════════════════
-
-class SampleRateConverter {
-private:
-    constexpr static int SINC_TAPS = 128;
-    std::array<double, SINC_TAPS> sincTable;
-    std::vector<double> inputBuffer;
-    int inputIndex = 0;
-
-    void generateSincTable() {
-        for (int i = 0; i < SINC_TAPS; ++i) {
-            int n = i - SINC_TAPS / 2;
-            double x = n * 0.5;
-
-            // Windowed sinc
-            double sinc = (x == 0.0) ? 1.0 : std::sin(PI * x) / (PI * x);
-
-            // Kaiser window (beta = 8.0 for high-quality SRC)
-            double kaiser = 0.42 - 0.5 * std::cos(2.0 * PI * i / (SINC_TAPS - 1))
-                          + 0.08 * std::cos(4.0 * PI * i / (SINC_TAPS - 1));
-
-            sincTable[i] = sinc * kaiser;
-        }
-    }
-
-public:
-    SampleRateConverter() {
-        generateSincTable();
-        inputBuffer.resize(SINC_TAPS, 0.0);
-    }
-
-    // Interpolate single sample at arbitrary position
-    double interpolate(const std::vector<double>& samples, double position) {
-        int baseIndex = static_cast<int>(position);
-        double fraction = position - baseIndex;
-
-        double sum = 0.0;
-        for (int i = 0; i < SINC_TAPS; ++i) {
-            int sampleIndex = baseIndex + i - SINC_TAPS / 2;
-            if (sampleIndex >= 0 && sampleIndex < static_cast<int>(samples.size())) {
-                sum += samples[sampleIndex] * sincTable[i];
-            }
-        }
-
-        return sum;
-    }
-
-    // Convert sample rate (e.g., 44.1kHz → 48kHz)
-    std::vector<double> convert(const std::vector<double>& input,
-                                double inputRate,
-                                double outputRate) {
-        double ratio = outputRate / inputRate;
-        int outputLength = static_cast<int>(input.size() * ratio);
-        std::vector<double> output(outputLength);
-
-        for (int i = 0; i < outputLength; ++i) {
-            double inputPos = i / ratio;
-            output[i] = interpolate(input, inputPos);
-        }
-
-        return output;
-    }
-
-    void reset() {
-        std::fill(inputBuffer.begin(), inputBuffer.end(), 0.0);
-        inputIndex = 0;
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// EBU R128 LUFS METER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class LUFSMeter {
-private:
-    ZDFBiquad preFilterL, preFilterR;
-    ZDFBiquad rlbFilterL, rlbFilterR;
-    std::vector<double> integratedBuffer;
-    std::vector<double> shortTermBuffer;
-    std::vector<double> momentaryBuffer;
-    int shortTermIndex = 0;
-    int momentaryIndex = 0;
-    double sampleRate;
-    constexpr static double ABSOLUTE_GATE = -70.0;
-    constexpr static double RELATIVE_GATE_OFFSET = -10.0;
-
-public:
-    LUFSMeter(double sr = 48000.0) : sampleRate(sr) {
-        preFilterL.setCoefficients(100.0, 0.707, 0.0, ZDFBiquad::HIGHPASS);
-        preFilterR.setCoefficients(100.0, 0.707, 0.0, ZDFBiquad::HIGHPASS);
-        rlbFilterL.setCoefficients(1000.0, 0.707, 4.0, ZDFBiquad::HIGHSHELF);
-        rlbFilterR.setCoefficients(1000.0, 0.707, 4.0, ZDFBiquad::HIGHSHELF);
-
-        int shortTermSize = static_cast<int>(3.0 * sampleRate);
-        int momentarySize = static_cast<int>(0.4 * sampleRate);
-
-        shortTermBuffer.resize(shortTermSize, 0.0);
-        momentaryBuffer.resize(momentarySize, 0.0);
-    }
-
-    void processSample(double left, double right) {
-        double filteredL = rlbFilterL.process(preFilterL.process(left));
-        double filteredR = rlbFilterR.process(preFilterR.process(right));
-
-        double meanSquare = (filteredL * filteredL + filteredR * filteredR) / 2.0;
-
-        integratedBuffer.push_back(meanSquare);
-
-        shortTermBuffer[shortTermIndex] = meanSquare;
-        shortTermIndex = (shortTermIndex + 1) % shortTermBuffer.size();
-
-        momentaryBuffer[momentaryIndex] = meanSquare;
-        momentaryIndex = (momentaryIndex + 1) % momentaryBuffer.size();
-    }
-
-    double getIntegratedLUFS() {
-        if (integratedBuffer.empty()) return -70.0;
-
-        std::vector<double> gated;
-        for (double ms : integratedBuffer) {
-            double lufs = -0.691 + 10.0 * std::log10(ms);
-            if (lufs > ABSOLUTE_GATE) {
-                gated.push_back(ms);
-            }
-        }
-
-        if (gated.empty()) return -70.0;
-
-        double ungatedMean = 0.0;
-        for (double ms : gated) {
-            ungatedMean += ms;
-        }
-        ungatedMean /= gated.size();
-        double relativeGate = -0.691 + 10.0 * std::log10(ungatedMean) + RELATIVE_GATE_OFFSET;
-
-        std::vector<double> finalGated;
-        for (double ms : gated) {
-            double lufs = -0.691 + 10.0 * std::log10(ms);
-            if (lufs > relativeGate) {
-                finalGated.push_back(ms);
-            }
-        }
-
-        if (finalGated.empty()) return -70.0;
-
-        double finalMean = 0.0;
-        for (double ms : finalGated) {
-            finalMean += ms;
-        }
-        finalMean /= finalGated.size();
-
-        return -0.691 + 10.0 * std::log10(finalMean);
-    }
-
-    double getShortTermLUFS() {
-        double sum = 0.0;
-        for (double ms : shortTermBuffer) {
-            sum += ms;
-        }
-        double meanPower = sum / shortTermBuffer.size();
-        return -0.691 + 10.0 * std::log10(std::max(meanPower, 1e-10));
-    }
-
-    double getMomentaryLUFS() {
-        double sum = 0.0;
-        for (double ms : momentaryBuffer) {
-            sum += ms;
-        }
-        double meanPower = sum / momentaryBuffer.size();
-        return -0.691 + 10.0 * std::log10(std::max(meanPower, 1e-10));
-    }
-
-    // LRA (Loudness Range) - Measures macro-dynamics (verse-to-chorus variation)
-    // Returns difference between 10th and 95th percentiles in LU
-    double getLRA() {
-        if (integratedBuffer.size() < 10) return 0.0;
-
-        // Convert all samples to LUFS and apply absolute gate
-        std::vector<double> gatedLUFS;
-        for (double ms : integratedBuffer) {
-            double lufs = -0.691 + 10.0 * std::log10(std::max(ms, 1e-10));
-            if (lufs > ABSOLUTE_GATE) {
-                gatedLUFS.push_back(lufs);
-            }
-        }
-
-        if (gatedLUFS.size() < 10) return 0.0;
-
-        // Sort to find percentiles
-        std::sort(gatedLUFS.begin(), gatedLUFS.end());
-
-        // Calculate 10th and 95th percentile indices
-        size_t idx10 = static_cast<size_t>(gatedLUFS.size() * 0.10);
-        size_t idx95 = static_cast<size_t>(gatedLUFS.size() * 0.95);
-
-        // Ensure indices are within bounds
-        idx10 = std::min(idx10, gatedLUFS.size() - 1);
-        idx95 = std::min(idx95, gatedLUFS.size() - 1);
-
-        // LRA is the difference
-        double lra = gatedLUFS[idx95] - gatedLUFS[idx10];
-        return std::max(0.0, lra); // Ensure non-negative
-    }
-
-    void reset() {
-        integratedBuffer.clear();
-        std::fill(shortTermBuffer.begin(), shortTermBuffer.end(), 0.0);
-        std::fill(momentaryBuffer.begin(), momentaryBuffer.end(), 0.0);
-        shortTermIndex = 0;
-        momentaryIndex = 0;
-        preFilterL.reset();
-        preFilterR.reset();
-        rlbFilterL.reset();
-        rlbFilterR.reset();
-    }
-};
-
-// ═══════════════════════════════════════════════════════════════════════════
-// CREST FACTOR ANALYZER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class CrestFactorAnalyzer {
-private:
-    std::vector<double> rmsBuffer;
-    int rmsIndex;
-    int bufferSize;
-    double peakValue;
-    double rmsSum;
-
-public:
-    CrestFactorAnalyzer(int windowSamples = 4800)
-        : bufferSize(windowSamples), rmsIndex(0), peakValue(0.0), rmsSum(0.0) {
-        rmsBuffer.resize(bufferSize, 0.0);
-    }
-
-    void processSample(double left, double right) {
-        double peak = std::max(std::abs(left), std::abs(right));
-        peakValue = std::max(peakValue * 0.999, peak);
-
-        double meanSquare = (left * left + right * right) / 2.0;
-
-        rmsSum -= rmsBuffer[rmsIndex];
-        rmsBuffer[rmsIndex] = meanSquare;
-        rmsSum += meanSquare;
-
-        rmsIndex = (rmsIndex + 1) % bufferSize;
-    }
-
-    double getCrestFactor() {
-        double rms = std::sqrt(rmsSum / bufferSize);
-        if (rms < 1e-10) return 100.0;
-        return linearToDb(peakValue / rms);
-    }
-
-    double getPeak() {
-        return linearToDb(peakValue);
-    }
-
-    double getRMS() {
-        return linearToDb(std::sqrt(rmsSum / bufferSize));
-    }
-
-    void reset() {
-        std::fill(rmsBuffer.begin(), rmsBuffer.end(), 0.0);
-        rmsIndex = 0;
-        peakValue = 0.0;
-        rmsSum = 0.0;
-    }
-};
+#include "dsp/MasteringEngine.h"
+#include "dsp/SampleRateConverter.h"
 
-// ═══════════════════════════════════════════════════════════════════════════
-// MIX HEALTH ANALYZER
-// ═══════════════════════════════════════════════════════════════════════════
-
-class MixHealthAnalyzer {
-private:
-    bool clippingDetected = false;
-    bool phaseIssuesDetected = false;
-    std::string lufsWarning = "OK";
-    double peakSample = 0.0;
-    double phaseCorrelation = 0.0;
-    double lufs = -70.0;
-
-public:
-    void analyze(double peakDB, double phaseCorr, double integratedLUFS) {
-        peakSample = peakDB;
-        phaseCorrelation = phaseCorr;
-        lufs = integratedLUFS;
-
-        // Detect clipping
-        clippingDetected = (peakDB >= -0.1);
-
-        // Detect phase issues
-        phaseIssuesDetected = (phaseCorr < 0.3);  // Too narrow or out-of-phase
-
-        // LUFS warnings
-        if (lufs < -30.0) {
-            lufsWarning = "Way Too Quiet";
-        } else if (lufs < -20.0) {
-            lufsWarning = "Too Quiet";
-        } else if (lufs > -8.0) {
-            lufsWarning = "Way Too Loud";
-        } else if (lufs > -10.0) {
-            lufsWarning = "Too Loud";
-        } else {
-            lufsWarning = "OK";
-        }
-    }
-
-    val getReport() {
-        val report = val::object();
-        report.set("clippingDetected", clippingDetected);
-        report.set("phaseIssues", phaseIssuesDetected);
-        report.set("lufsWarning", lufsWarning);
-        report.set("peakDB", peakSample);
-        report.set("phaseCorrelation", phaseCorrelation);
-        report.set("integratedLUFS", lufs);
-        return report;
-    }
-};
+using namespace emscripten;
 
 // ═══════════════════════════════════════════════════════════════════════════
-// 100% ULTIMATE LEGENDARY MASTERING ENGINE
+// JS ADAPTERS (val <-> plain C++ types)
 // ═══════════════════════════════════════════════════════════════════════════
 
-class MasteringEngine {
-private:
-    double sampleRate;
-
-    // ═══ SIGNAL CHAIN (COMPLETE, IN PERFECT ORDER) ═══
-    DCOffsetFilter dcFilterL, dcFilterR;  // 0. DC Offset Removal
-    ParameterSmoother inputGain;          // 1. Input Gain / Trim
-    SevenBandEQ eqL, eqR;                 // 2. ZDF EQ
-    HighFrequencyProtection hfProtectL, hfProtectR;  // 2b. Air Band Protection (NEW!)
-    DeEsser deEsserL, deEsserR;           // 3. De-Esser
-    MultibandCompressor multibandComp;    // 4. Multiband Compressor
-    StereoImager stereoImager;            // 5. Stereo Imager
-    AnalogSaturation saturationL, saturationR;  // 6. Saturation
-    TruePeakLimiter limiter;              // 7. True-Peak Limiter (with Safe-Clip)
-    Dithering ditheringL, ditheringR;     // 8. Dithering
-
-    // Metering & Analysis
-    LUFSMeter lufsMeter;
-    CrestFactorAnalyzer crestAnalyzer;
-    MixHealthAnalyzer healthAnalyzer;
-    double phaseCorrelation = 0.0;
-
-    // Phase correlation calculation
-    double sumLL = 0.0;
-    double sumRR = 0.0;
-    double sumLR = 0.0;
-    int correlationSamples = 0;
-    constexpr static int CORRELATION_WINDOW = 4800;
-
-    bool aiEnabled = false;
-
-public:
-    MasteringEngine(double sr = 48000.0)
-        : sampleRate(sr), limiter(sr), lufsMeter(sr), crestAnalyzer(4800) {
-        eqL.setSampleRate(sr);
-        eqR.setSampleRate(sr);
-        hfProtectL.setSampleRate(sr);
-        hfProtectR.setSampleRate(sr);
-        deEsserL.setSampleRate(sr);
-        deEsserR.setSampleRate(sr);
-        multibandComp.setSampleRate(sr);
-        stereoImager.setSampleRate(sr);
-        saturationL.setSampleRate(sr);
-        saturationR.setSampleRate(sr);
-        inputGain.setSmoothTime(20.0, sr);
-        inputGain.setImmediate(0.0);
-    }
-
-    void setSampleRate(double sr) {
-        sampleRate = sr;
-        eqL.setSampleRate(sr);
-        eqR.setSampleRate(sr);
-        hfProtectL.setSampleRate(sr);
-        hfProtectR.setSampleRate(sr);
-        deEsserL.setSampleRate(sr);
-        deEsserR.setSampleRate(sr);
-        multibandComp.setSampleRate(sr);
-        stereoImager.setSampleRate(sr);
-        saturationL.setSampleRate(sr);
-        saturationR.setSampleRate(sr);
-        limiter.setSampleRate(sr);
-        inputGain.setSmoothTime(20.0, sr);
-    }
-
-    // ═══════════════════════════════════════════════════════════════════════
-    // CONTROL METHODS
-    // ═══════════════════════════════════════════════════════════════════════
-
-    // DC Offset Filter
-    void setDCOffsetFilterEnabled(bool enabled) {
-        dcFilterL.setEnabled(enabled);
-        dcFilterR.setEnabled(enabled);
-    }
-
-    // Input Gain
-    void setInputGain(double gainDB) {
-        inputGain.setTarget(gainDB);
-    }
-
-    // EQ
-    void setEQGain(int band, double gainDB) {
-        eqL.setBandGain(band, gainDB);
-        eqR.setBandGain(band, gainDB);
-    }
-
-    void setAllEQGains(val gainsArray) {
-        std::array<double, 7> gains;
-        for (int i = 0; i < 7; ++i) {
-            gains[i] = gainsArray[i].as<double>();
-        }
-        eqL.setAllGains(gains);
-        eqR.setAllGains(gains);
-    }
-
-    // De-Esser (NEW!)
-    void setDeEsserEnabled(bool enabled) {
-        deEsserL.setEnabled(enabled);
-        deEsserR.setEnabled(enabled);
-    }
-
-    void setDeEsserThreshold(double thresholdDB) {
-        deEsserL.setThreshold(thresholdDB);
-        deEsserR.setThreshold(thresholdDB);
-    }
-
-    void setDeEsserRatio(double ratio) {
-        deEsserL.setRatio(ratio);
-        deEsserR.setRatio(ratio);
-    }
-
-    // Multiband Compressor
-    void setMultibandEnabled(bool enabled) {
-        multibandComp.setEnabled(enabled);
-    }
-
-    void setMultibandLowBand(double threshold, double ratio) {
-        multibandComp.setLowBand(threshold, ratio);
+template <typename Engine>
+void setAllEQGainsFromJS(Engine& engine, val gainsArray) {
+    std::array<double, 7> gains;
+    for (int i = 0; i < 7; ++i) {
+        gains[i] = gainsArray[i].as<double>();
     }
+    engine.setAllEQGains(gains);
+}
 
-    void setMultibandMidBand(double threshold, double ratio) {
-        multibandComp.setMidBand(threshold, ratio);
-    }
-
-    void setMultibandHighBand(double threshold, double ratio) {
-        multibandComp.setHighBand(threshold, ratio);
-    }
-
-    // Stereo Imager
-    void setStereoWidth(double width) {
-        stereoImager.setWidth(width);
-    }
-
-    // Saturation
-    void setSaturationDrive(double drive) {
-        saturationL.setDrive(drive);
-        saturationR.setDrive(drive);
-    }
-
-    void setSaturationMix(double mix) {
-        saturationL.setMix(mix);
-        saturationR.setMix(mix);
-    }
-
-    // Limiter (with Safe-Clip mode - NEW!)
-    void setLimiterThreshold(double thresholdDB) {
-        limiter.setThreshold(thresholdDB);
-    }
-
-    void setLimiterRelease(double releaseSec) {
-        limiter.setRelease(releaseSec);
-    }
-
-    void setLimiterSafeClipMode(bool enabled) {
-        limiter.setSafeClipMode(enabled);
-    }
-
-    // Dithering
-    void setDitheringEnabled(bool enabled) {
-        ditheringL.setEnabled(enabled);
-        ditheringR.setEnabled(enabled);
-    }
-
-    void setDitheringBits(int bits) {
-        ditheringL.setTargetBits(bits);
-        ditheringR.setTargetBits(bits);
-    }
-
-    // AI
-    void setAIEnabled(bool enabled) {
-        aiEnabled = enabled;
-    }
-
-    // ═══════════════════════════════════════════════════════════════════════
-    // ✨ 100% ULTIMATE LEGENDARY SIGNAL FLOW ✨
-    // ═══════════════════════════════════════════════════════════════════════
-
-    void processStereo(double& left, double& right) {
-        // ═══ 0. DC OFFSET REMOVAL ═══
-        left = dcFilterL.process(left);
-        right = dcFilterR.process(right);
-
-        // ═══ 1. INPUT GAIN / TRIM ═══
-        double gainLinear = dbToLinear(inputGain.getSmoothed());
-        left *= gainLinear;
-        right *= gainLinear;
-
-        // ═══ 2. ZDF EQ (with Nyquist De-cramping) ═══
-        left = eqL.process(left);
-        right = eqR.process(right);
-
-        // ═══ 2b. HIGH-FREQUENCY AIR PROTECTION (prevents harsh square waves) ═══
-        left = hfProtectL.process(left);
-        right = hfProtectR.process(right);
-
-        // ═══ 3. INTELLIGENT DE-ESSER ═══
-        left = deEsserL.process(left);
-        right = deEsserR.process(right);
-
-        // ═══ 4. STEREO IMAGER / MONO-BASS (widen BEFORE compression) ═══
-        stereoImager.processStereo(left, right);
-
-        // ═══ 5. MULTIBAND COMPRESSOR (glues the widened signal) ═══
-        multibandComp.processStereo(left, right);
-
-        // ═══ 6. ANALOG SATURATION / SOFT-CLIPPER ═══
-        left = saturationL.process(left);
-        right = saturationR.process(right);
-
-        // ═══ 7. TRUE-PEAK LIMITER (4x oversampling + Safe-Clip mode) ═══
-        limiter.processStereo(left, right);
-
-        // ═══ 8. DITHERING (TPDF for bit-depth reduction) ═══
-        left = ditheringL.process(left);
-        right = ditheringR.process(right);
-
-        // ═══ METERING ═══
-        lufsMeter.processSample(left, right);
-        crestAnalyzer.processSample(left, right);
-
-        sumLL += left * left;
-        sumRR += right * right;
-        sumLR += left * right;
-        correlationSamples++;
-
-        if (correlationSamples >= CORRELATION_WINDOW) {
-            double denominator = std::sqrt(sumLL * sumRR);
-            phaseCorrelation = (denominator > 1e-10) ? (sumLR / denominator) : 0.0;
-
-            // Update health report
-            healthAnalyzer.analyze(
-                crestAnalyzer.getPeak(),
-                phaseCorrelation,
-                lufsMeter.getIntegratedLUFS()
-            );
-
-            if (aiEnabled) {
-                applyAIAdjustments();
-            }
-
-            sumLL = sumRR = sumLR = 0.0;
-            correlationSamples = 0;
-        }
-    }
-
-    void processBuffer(val inputBuffer, val outputBuffer, int numSamples) {
-        for (int i = 0; i < numSamples; ++i) {
-            double left = inputBuffer[i * 2].as<double>();
-            double right = inputBuffer[i * 2 + 1].as<double>();
-
-            processStereo(left, right);
-
-            outputBuffer.set(i * 2, left);
-            outputBuffer.set(i * 2 + 1, right);
-        }
-    }
-
-    // ═══════════════════════════════════════════════════════════════════════
-    // AI AUTO-MASTERING
-    // ═══════════════════════════════════════════════════════════════════════
-
-    void applyAIAdjustments() {
-        double cf = crestAnalyzer.getCrestFactor();
-
-        if (cf > 15.0) {
-            multibandComp.setEnabled(true);
-            multibandComp.setLowBand(-24.0, 3.0);
-            multibandComp.setMidBand(-20.0, 3.5);
-            multibandComp.setHighBand(-18.0, 4.0);
-        } else if (cf > 12.0) {
-            multibandComp.setEnabled(true);
-            multibandComp.setLowBand(-20.0, 2.5);
-            multibandComp.setMidBand(-18.0, 3.0);
-            multibandComp.setHighBand(-16.0, 3.5);
-        } else if (cf > 8.0) {
-            multibandComp.setEnabled(true);
-            multibandComp.setLowBand(-18.0, 2.0);
-            multibandComp.setMidBand(-16.0, 2.0);
-            multibandComp.setHighBand(-14.0, 2.5);
-        } else {
-            multibandComp.setEnabled(false);
-        }
-    }
+// Legacy interleaved path: four val round-trips per stereo frame.
+// Prefer processBlock() / processQueued().
+template <typename Engine>
+void processBufferFromJS(Engine& engine, val inputBuffer, val outputBuffer, int numSamples) {
+    RealtimeScope realtime("processBuffer");
+    engine.applyPendingCommands();
 
-    // ═══════════════════════════════════════════════════════════════════════
-    // METERING & UTILITIES
-    // ═══════════════════════════════════════════════════════════════════════
+    for (int i = 0; i < numSamples; ++i) {
+        using Sample = typename Engine::SampleType;
+        Sample left = static_cast<Sample>(inputBuffer[i * 2].as<double>());
+        Sample right = static_cast<Sample>(inputBuffer[i * 2 + 1].as<double>());
 
-    double getIntegratedLUFS() { return lufsMeter.getIntegratedLUFS(); }
-    double getShortTermLUFS() { return lufsMeter.getShortTermLUFS(); }
-    double getMomentaryLUFS() { return lufsMeter.getMomentaryLUFS(); }
-    double getLRA() { return lufsMeter.getLRA(); }
-    double getPhaseCorrelation() { return phaseCorrelation; }
-    double getCrestFactor() { return crestAnalyzer.getCrestFactor(); }
-    double getLimiterGainReduction() { return limiter.getGainReduction(); }
-    double getPeakDB() { return crestAnalyzer.getPeak(); }
-    double getRMSDB() { return crestAnalyzer.getRMS(); }
-    double getDeEsserGainReduction() { return deEsserL.getGainReduction(); }
+        engine.processStereo(left, right);
 
-    // Latency Compensation (NEW!)
-    int getLatencySamples() {
-        return LOOKAHEAD_SAMPLES;  // 50ms @ 48kHz = 2400 samples
+        outputBuffer.set(i * 2, static_cast<double>(left));
+        outputBuffer.set(i * 2 + 1, static_cast<double>(right));
     }
 
-    // Mix Health Report (NEW!)
-    val getMixHealthReport() {
-        return healthAnalyzer.getReport();
-    }
+    engine.advanceMeterClock(numSamples);
+}
 
-    void reset() {
-        dcFilterL.reset();
-        dcFilterR.reset();
-        eqL.reset();
-        eqR.reset();
-        hfProtectL.reset();
-        hfProtectR.reset();
-        deEsserL.reset();
-        deEsserR.reset();
-        multibandComp.reset();
-        stereoImager.reset();
-        saturationL.reset();
-        saturationR.reset();
-        limiter.reset();
-        ditheringL.reset();
-        ditheringR.reset();
-        lufsMeter.reset();
-        crestAnalyzer.reset();
-        sumLL = sumRR = sumLR = 0.0;
-        correlationSamples = 0;
-        phaseCorrelation = 0.0;
-    }
-};
+template <typename Engine>
+val getMixHealthReportForJS(const Engine& engine) {
+    MixHealthReport health = engine.getMixHealthReport();
+    val report = val::object();
+    report.set("clippingDetected", health.clippingDetected);
+    report.set("phaseIssues", health.phaseIssues);
+    report.set("lufsWarning", std::string(health.lufsWarning));
+    report.set("peakDB", health.peakDB);
+    report.set("phaseCorrelation", health.phaseCorrelation);
+    report.set("integratedLUFS", health.integratedLUFS);
+    return report;
+}
 
 // ═══════════════════════════════════════════════════════════════════════════
 // EMSCRIPTEN BINDINGS
 // ═══════════════════════════════════════════════════════════════════════════
 
-EMSCRIPTEN_BINDINGS(mastering_engine) {
-    class_<MasteringEngine>("MasteringEngine")
-        .constructor<double>()
-        .function("setSampleRate", &MasteringEngine::setSampleRate)
+// Same JS surface for every engine build; only the class name differs
+template <typename Engine>
+void bindEngine(const char* name) {
+    class_<Engine>(name)
+        .template constructor<double>()
+        .function("setSampleRate", &Engine::setSampleRate)
 
         // DC Offset Filter
-        .function("setDCOffsetFilterEnabled", &MasteringEngine::setDCOffsetFilterEnabled)
+        .function("setDCOffsetFilterEnabled", &Engine::setDCOffsetFilterEnabled)
 
         // Input Gain
-        .function("setInputGain", &MasteringEngine::setInputGain)
+        .function("setInputGain", &Engine::setInputGain)
 
         // EQ
-        .function("setEQGain", &MasteringEngine::setEQGain)
-        .function("setAllEQGains", &MasteringEngine::setAllEQGains)
+        .function("setEQGain", &Engine::setEQGain)
+        .function("setAllEQGains", &setAllEQGainsFromJS<Engine>)
 
         // De-Esser (NEW!)
-        .function("setDeEsserEnabled", &MasteringEngine::setDeEsserEnabled)
-        .function("setDeEsserThreshold", &MasteringEngine::setDeEsserThreshold)
-        .function("setDeEsserRatio", &MasteringEngine::setDeEsserRatio)
+        .function("setDeEsserEnabled", &Engine::setDeEsserEnabled)
+        .function("setDeEsserThreshold", &Engine::setDeEsserThreshold)
+        .function("setDeEsserRatio", &Engine::setDeEsserRatio)
 
         // Multiband Compressor
-        .function("setMultibandEnabled", &MasteringEngine::setMultibandEnabled)
-        .function("setMultibandLowBand", &MasteringEngine::setMultibandLowBand)
-        .function("setMultibandMidBand", &MasteringEngine::setMultibandMidBand)
-        .function("setMultibandHighBand", &MasteringEngine::setMultibandHighBand)
+        .function("setMultibandEnabled", &Engine::setMultibandEnabled)
+        .function("setMultibandLowBand", &Engine::setMultibandLowBand)
+        .function("setMultibandMidBand", &Engine::setMultibandMidBand)
+        .function("setMultibandHighBand", &Engine::setMultibandHighBand)
+        .function("setMultibandKnee", &Engine::setMultibandKnee)
+        .function("setMultibandStereoLink", &Engine::setMultibandStereoLink)
 
         // Stereo Imager
-        .function("setStereoWidth", &MasteringEngine::setStereoWidth)
+        .function("setStereoWidth", &Engine::setStereoWidth)
 
         // Saturation
-        .function("setSaturationDrive", &MasteringEngine::setSaturationDrive)
-        .function("setSaturationMix", &MasteringEngine::setSaturationMix)
+        .function("setSaturationDrive", &Engine::setSaturationDrive)
+        .function("setSaturationMix", &Engine::setSaturationMix)
 
         // Limiter (with Safe-Clip - NEW!)
-        .function("setLimiterThreshold", &MasteringEngine::setLimiterThreshold)
-        .function("setLimiterRelease", &MasteringEngine::setLimiterRelease)
-        .function("setLimiterSafeClipMode", &MasteringEngine::setLimiterSafeClipMode)
+        .function("setLimiterThreshold", &Engine::setLimiterThreshold)
+        .function("setLimiterRelease", &Engine::setLimiterRelease)
+        .function("setLimiterSafeClipMode", &Engine::setLimiterSafeClipMode)
+        .function("setLowLatencyOversampling", &Engine::setLowLatencyOversampling)
+        .function("setLimiterLookAhead", &Engine::setLimiterLookAhead)
+        .function("getLimiterLookAhead", &Engine::getLimiterLookAhead)
 
         // Dithering
-        .function("setDitheringEnabled", &MasteringEngine::setDitheringEnabled)
-        .function("setDitheringBits", &MasteringEngine::setDitheringBits)
+        .function("setDitheringEnabled", &Engine::setDitheringEnabled)
+        .function("setDitheringBits", &Engine::setDitheringBits)
+        .function("setDitheringNoiseShaping", &Engine::setDitheringNoiseShaping)
 
         // AI
-        .function("setAIEnabled", &MasteringEngine::setAIEnabled)
+        .function("setAIEnabled", &Engine::setAIEnabled)
+
+        // Parameter command queue (applied at block boundaries)
+        .function("pushParameter", &Engine::pushParameter)
+        .function("getCommandQueuePtr", &Engine::getCommandQueuePtr)
 
         // Processing
-        .function("processBuffer", &MasteringEngine::processBuffer)
+        .function("processBuffer", &processBufferFromJS<Engine>)
+        .function("processBlock", &Engine::processBlock)
+        .function("getLeftBufferPtr", &Engine::getLeftBufferPtr)
+        .function("getRightBufferPtr", &Engine::getRightBufferPtr)
+        .function("getMaxBlockSize", &Engine::getMaxBlockSize)
+
+        // Streaming (SPSC ring buffers)
+        .function("processQueued", &Engine::processQueued)
+        .function("resetStream", &Engine::resetStream)
+        .function("setInternalBlockSize", &Engine::setInternalBlockSize)
+        .function("getInternalBlockSize", &Engine::getInternalBlockSize)
+        .function("getStreamLatencySamples", &Engine::getStreamLatencySamples)
+        .function("getInputRingPtr", &Engine::getInputRingPtr)
+        .function("getOutputRingPtr", &Engine::getOutputRingPtr)
 
         // Metering
-        .function("getIntegratedLUFS", &MasteringEngine::getIntegratedLUFS)
-        .function("getShortTermLUFS", &MasteringEngine::getShortTermLUFS)
-        .function("getMomentaryLUFS", &MasteringEngine::getMomentaryLUFS)
-        .function("getLRA", &MasteringEngine::getLRA)
-        .function("getPhaseCorrelation", &MasteringEngine::getPhaseCorrelation)
-        .function("getCrestFactor", &MasteringEngine::getCrestFactor)
-        .function("getLimiterGainReduction", &MasteringEngine::getLimiterGainReduction)
-        .function("getPeakDB", &MasteringEngine::getPeakDB)
-        .function("getRMSDB", &MasteringEngine::getRMSDB)
-        .function("getDeEsserGainReduction", &MasteringEngine::getDeEsserGainReduction)
+        .function("getIntegratedLUFS", &Engine::getIntegratedLUFS)
+        .function("getShortTermLUFS", &Engine::getShortTermLUFS)
+        .function("getMomentaryLUFS", &Engine::getMomentaryLUFS)
+        .function("getLRA", &Engine::getLRA)
+        .function("getPhaseCorrelation", &Engine::getPhaseCorrelation)
+        .function("getCrestFactor", &Engine::getCrestFactor)
+        .function("getLimiterGainReduction", &Engine::getLimiterGainReduction)
+        .function("getPeakDB", &Engine::getPeakDB)
+        .function("getRMSDB", &Engine::getRMSDB)
+        .function("getDeEsserGainReduction", &Engine::getDeEsserGainReduction)
+        .function("getTruePeakDB", &Engine::getTruePeakDB)
+        .function("getMeterSnapshotPtr", &Engine::getMeterSnapshotPtr)
 
         // Utilities (NEW!)
-        .function("getLatencySamples", &MasteringEngine::getLatencySamples)
-        .function("getMixHealthReport", &MasteringEngine::getMixHealthReport)
+        .function("getLatencySamples", &Engine::getLatencySamples)
+        .function("getMixHealthReport", &getMixHealthReportForJS<Engine>)
 
         // Reset
-        .function("reset", &MasteringEngine::reset);
+        .function("reset", &Engine::reset);
+}
+
+EMSCRIPTEN_BINDINGS(mastering_engine) {
+    // Standard 4x true-peak oversampling, double precision
+    bindEngine<MasteringEngine>("MasteringEngine");
+
+    // Cheap live preview: float32 chain, 2x true-peak oversampling
+    bindEngine<MasteringEnginePreview>("MasteringEnginePreview");
 
     // Sample Rate Converter (standalone utility)
     class_<SampleRateConverter>("SampleRateConverter")
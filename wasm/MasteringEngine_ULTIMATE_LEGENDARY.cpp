@@ -32,6 +32,7 @@
 #include <vector>
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <random>
 
 using namespace emscripten;
@@ -1118,6 +1119,11 @@ private:
     int correlationSamples = 0;
     constexpr static int CORRELATION_WINDOW = 4800;
 
+    // Engine-owned planar block buffers for processBlock() (WASM heap)
+    constexpr static int MAX_BLOCK_SIZE = 4096;
+    std::array<float, MAX_BLOCK_SIZE> blockBufferL{};
+    std::array<float, MAX_BLOCK_SIZE> blockBufferR{};
+
     bool aiEnabled = false;
 
 public:
@@ -1284,6 +1290,29 @@ public:
         }
     }
 
+    // Zero-copy block processing (planar float32, in place).
+    // The worklet copies each channel into the engine-owned heap buffers
+    // once with HEAPF32.set() and makes a single call per render quantum,
+    // instead of four val round-trips per stereo frame in processBuffer().
+    void processBlock(uintptr_t leftPtr, uintptr_t rightPtr, int numSamples) {
+        float* leftBuffer = reinterpret_cast<float*>(leftPtr);
+        float* rightBuffer = reinterpret_cast<float*>(rightPtr);
+
+        for (int i = 0; i < numSamples; ++i) {
+            double left = leftBuffer[i];
+            double right = rightBuffer[i];
+
+            processStereo(left, right);
+
+            leftBuffer[i] = static_cast<float>(left);
+            rightBuffer[i] = static_cast<float>(right);
+        }
+    }
+
+    uintptr_t getLeftBufferPtr() { return reinterpret_cast<uintptr_t>(blockBufferL.data()); }
+    uintptr_t getRightBufferPtr() { return reinterpret_cast<uintptr_t>(blockBufferR.data()); }
+    int getMaxBlockSize() { return MAX_BLOCK_SIZE; }
+
     // ═══════════════════════════════════════════════════════════════════════
     // AI AUTO-MASTERING
     // ═══════════════════════════════════════════════════════════════════════
@@ -1384,6 +1413,10 @@ EMSCRIPTEN_BINDINGS(mastering_engine) {
 
         // Processing
         .function("processBuffer", &MasteringEngine::processBuffer)
+        .function("processBlock", &MasteringEngine::processBlock)
+        .function("getLeftBufferPtr", &MasteringEngine::getLeftBufferPtr)
+        .function("getRightBufferPtr", &MasteringEngine::getRightBufferPtr)
+        .function("getMaxBlockSize", &MasteringEngine::getMaxBlockSize)
 
         // Metering
         .function("getIntegratedLUFS", &MasteringEngine::getIntegratedLUFS)
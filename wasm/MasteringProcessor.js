@@ -9,6 +9,177 @@
 let MasteringEngineModule = null;
 let engineInstance = null;
 
+// Keep in sync with ParamID in dsp/ParameterCommandQueue.h
+const ParamID = Object.freeze({
+    INPUT_GAIN: 0,
+    DC_FILTER_ENABLED: 1,
+    EQ_GAIN: 2,              // index = band (0-6)
+    DEESSER_ENABLED: 3,
+    DEESSER_THRESHOLD: 4,
+    DEESSER_RATIO: 5,
+    MULTIBAND_ENABLED: 6,
+    MULTIBAND_THRESHOLD: 7,  // index = band (0 low, 1 mid, 2 high)
+    MULTIBAND_RATIO: 8,      // index = band (0 low, 1 mid, 2 high)
+    STEREO_WIDTH: 9,
+    SATURATION_DRIVE: 10,
+    SATURATION_MIX: 11,
+    LIMITER_THRESHOLD: 12,
+    LIMITER_RELEASE: 13,
+    LIMITER_SAFE_CLIP: 14,
+    DITHERING_ENABLED: 15,
+    DITHERING_BITS: 16,
+    AI_ENABLED: 17,
+    MULTIBAND_KNEE: 18,      // index = band (0 low, 1 mid, 2 high)
+    MULTIBAND_STEREO_LINK: 19,
+    DITHERING_NOISE_SHAPING: 20  // 0 flat, 1 F-weighted, 2 high-pass
+});
+
+// Parameters waiting for queue space are keyed id * stride + index
+// (indices are small band numbers)
+const PENDING_KEY_STRIDE = 256;
+
+/**
+ * JS side of the engine's ParameterCommandQueue. Commands are 16-byte
+ * records {uint32 id, int32 index, float64 value} after a 16-byte header;
+ * the engine drains them once per block before processing.
+ */
+class WasmCommandQueue {
+    constructor(module, ptr) {
+        this.module = module;
+        this.ptr = ptr;
+        this.refreshViews();
+    }
+
+    refreshViews() {
+        this.buffer = this.module.HEAPF32.buffer;
+        this.header = new Uint32Array(this.buffer, this.ptr, 4);
+        this.capacity = this.header[2];
+        this.mask = this.capacity - 1;
+        this.words = new Int32Array(this.buffer, this.ptr + 16, this.capacity * 4);
+        this.values = new Float64Array(this.buffer, this.ptr + 16, this.capacity * 2);
+    }
+
+    // Returns false if the queue is full (command dropped)
+    push(id, index, value) {
+        if (this.buffer !== this.module.HEAPF32.buffer) this.refreshViews();
+
+        const w = Atomics.load(this.header, 0);
+        const r = Atomics.load(this.header, 1);
+        if (((w - r) >>> 0) >= this.capacity) return false;
+
+        const slot = w & this.mask;
+        this.words[slot * 4] = id;
+        this.words[slot * 4 + 1] = index;
+        this.values[slot * 2 + 1] = value;
+        Atomics.store(this.header, 0, (w + 1) >>> 0);
+        return true;
+    }
+}
+
+/**
+ * Reader for the engine's seqlock-protected MeterSnapshot.
+ * Layout: [sequence, fieldCount] as uint32, then float64 fields.
+ */
+class WasmMeterSnapshot {
+    constructor(module, ptr) {
+        this.module = module;
+        this.ptr = ptr;
+        this.refreshViews();
+    }
+
+    refreshViews() {
+        this.buffer = this.module.HEAPF32.buffer;
+        this.header = new Uint32Array(this.buffer, this.ptr, 2);
+        this.fields = new Float64Array(this.buffer, this.ptr + 8, this.header[1]);
+    }
+
+    // Returns null if the engine kept writing during every attempt
+    read() {
+        if (this.buffer !== this.module.HEAPF32.buffer) this.refreshViews();
+
+        for (let attempt = 0; attempt < 4; attempt++) {
+            const before = Atomics.load(this.header, 0);
+            if (before & 1) continue;
+
+            const f = this.fields;
+            const snapshot = {
+                momentaryLUFS: f[0],
+                shortTermLUFS: f[1],
+                integratedLUFS: f[2],
+                loudnessRange: f[3],
+                truePeakDB: f[4],
+                crestFactor: f[5],
+                phaseCorrelation: f[6],
+                deEsserGainReduction: f[7],
+                limiterGainReduction: f[8]
+            };
+
+            if (Atomics.load(this.header, 0) === before) return snapshot;
+        }
+        return null;
+    }
+}
+
+/**
+ * JS side of an AudioRingBuffer living in WASM memory
+ * (see dsp/AudioRingBuffer.h).
+ * Header: [writeIndex, readIndex, capacity, reserved] as uint32, followed by
+ * planar float32 left/right data. Indices go through Atomics so the engine
+ * can drain the ring from another thread when the memory is a SharedArrayBuffer.
+ */
+class WasmAudioRing {
+    constructor(module, ptr) {
+        this.module = module;
+        this.ptr = ptr;
+        this.refreshViews();
+    }
+
+    refreshViews() {
+        this.buffer = this.module.HEAPF32.buffer;
+        this.header = new Uint32Array(this.buffer, this.ptr, 4);
+        this.capacity = this.header[2];
+        this.mask = this.capacity - 1;
+        this.left = new Float32Array(this.buffer, this.ptr + 16, this.capacity);
+        this.right = new Float32Array(this.buffer, this.ptr + 16 + this.capacity * 4, this.capacity);
+    }
+
+    // Producer: returns false (and writes nothing) if the quantum does not fit
+    write(leftIn, rightIn) {
+        if (this.buffer !== this.module.HEAPF32.buffer) this.refreshViews();
+
+        const numFrames = leftIn.length;
+        const w = Atomics.load(this.header, 0);
+        const r = Atomics.load(this.header, 1);
+        if (this.capacity - ((w - r) >>> 0) < numFrames) return false;
+
+        for (let i = 0; i < numFrames; i++) {
+            const index = (w + i) & this.mask;
+            this.left[index] = leftIn[i];
+            this.right[index] = rightIn[i];
+        }
+        Atomics.store(this.header, 0, (w + numFrames) >>> 0);
+        return true;
+    }
+
+    // Consumer: returns false (and reads nothing) on underrun
+    read(leftOut, rightOut) {
+        if (this.buffer !== this.module.HEAPF32.buffer) this.refreshViews();
+
+        const numFrames = leftOut.length;
+        const r = Atomics.load(this.header, 1);
+        const w = Atomics.load(this.header, 0);
+        if (((w - r) >>> 0) < numFrames) return false;
+
+        for (let i = 0; i < numFrames; i++) {
+            const index = (r + i) & this.mask;
+            leftOut[i] = this.left[index];
+            rightOut[i] = this.right[index];
+        }
+        Atomics.store(this.header, 1, (r + numFrames) >>> 0);
+        return true;
+    }
+}
+
 class MasteringProcessor extends AudioWorkletProcessor {
     constructor(options) {
         super();
@@ -21,10 +192,18 @@ class MasteringProcessor extends AudioWorkletProcessor {
         this.limiterThreshold = -1.0;        // dBTP
         this.limiterRelease = 0.05;          // 50ms
 
+        // Latest value per (id, index) that did not fit in the command queue
+        this.pendingParameters = new Map();
+
         // Metering output
         this.meteringCounter = 0;
         this.meteringInterval = 2048; // Send metering updates every 2048 samples (~43ms @ 48kHz)
 
+        // Stream glitches, reported with the metering cadence when they change
+        this.overruns = 0;            // Input ring full: rings re-primed
+        this.underruns = 0;           // Output ring empty: silence emitted
+        this.reportedXruns = 0;
+
         // Handle messages from main thread
         this.port.onmessage = this.handleMessage.bind(this);
 
@@ -45,7 +224,7 @@ class MasteringProcessor extends AudioWorkletProcessor {
             case 'set_eq_gain':
                 if (this.initialized && data.band !== undefined && data.gain !== undefined) {
                     this.eqGains[data.band] = data.gain;
-                    engineInstance.setEQGain(data.band, data.gain);
+                    this.queueParameter(ParamID.EQ_GAIN, data.band, data.gain);
                 }
                 break;
 
@@ -53,22 +232,54 @@ class MasteringProcessor extends AudioWorkletProcessor {
                 if (this.initialized && data.gains && data.gains.length === 7) {
                     for (let i = 0; i < 7; i++) {
                         this.eqGains[i] = data.gains[i];
+                        this.queueParameter(ParamID.EQ_GAIN, i, data.gains[i]);
                     }
-                    engineInstance.setAllEQGains(data.gains);
                 }
                 break;
 
             case 'set_limiter_threshold':
                 if (this.initialized && data.threshold !== undefined) {
                     this.limiterThreshold = data.threshold;
-                    engineInstance.setLimiterThreshold(data.threshold);
+                    this.queueParameter(ParamID.LIMITER_THRESHOLD, 0, data.threshold);
                 }
                 break;
 
             case 'set_limiter_release':
                 if (this.initialized && data.release !== undefined) {
                     this.limiterRelease = data.release;
-                    engineInstance.setLimiterRelease(data.release);
+                    this.queueParameter(ParamID.LIMITER_RELEASE, 0, data.release);
+                }
+                break;
+
+            case 'set_parameter':
+                // Generic automation path: { id: ParamID.*, index, value }
+                if (this.initialized && data.id !== undefined && data.value !== undefined) {
+                    this.queueParameter(data.id, data.index || 0, data.value);
+                }
+                break;
+
+            // These change the limiter's delay line, so they call the engine
+            // directly (between quanta, never mid-block) instead of going
+            // through the command queue, and report the new latency
+            case 'set_limiter_lookahead':
+                if (this.initialized && data.ms !== undefined) {
+                    engineInstance.setLimiterLookAhead(data.ms);
+                    this.postLatency('latency_changed');
+                }
+                break;
+
+            case 'set_low_latency_oversampling':
+                if (this.initialized && data.enabled !== undefined) {
+                    engineInstance.setLowLatencyOversampling(!!data.enabled);
+                    this.postLatency('latency_changed');
+                }
+                break;
+
+            case 'set_sample_rate':
+                if (this.initialized && data.sampleRate !== undefined) {
+                    this.sampleRate = data.sampleRate;
+                    engineInstance.setSampleRate(data.sampleRate);
+                    this.postLatency('latency_changed');
                 }
                 break;
 
@@ -97,19 +308,28 @@ class MasteringProcessor extends AudioWorkletProcessor {
             // Create engine instance
             engineInstance = new MasteringEngineModule.MasteringEngine(this.sampleRate);
 
+            // Quanta go through lock-free rings; the engine runs its chain in
+            // larger internal blocks (primed so the output never underruns)
+            engineInstance.resetStream(128);
+            this.inputRing = new WasmAudioRing(MasteringEngineModule, engineInstance.getInputRingPtr());
+            this.outputRing = new WasmAudioRing(MasteringEngineModule, engineInstance.getOutputRingPtr());
+
+            // Parameter changes are queued and applied at block boundaries
+            this.commands = new WasmCommandQueue(MasteringEngineModule, engineInstance.getCommandQueuePtr());
+
+            // Metering is published by the engine; read with no embind calls
+            this.meters = new WasmMeterSnapshot(MasteringEngineModule, engineInstance.getMeterSnapshotPtr());
+
             // Initialize with default settings
             for (let i = 0; i < 7; i++) {
-                engineInstance.setEQGain(i, this.eqGains[i]);
+                this.queueParameter(ParamID.EQ_GAIN, i, this.eqGains[i]);
             }
-            engineInstance.setLimiterThreshold(this.limiterThreshold);
-            engineInstance.setLimiterRelease(this.limiterRelease);
+            this.queueParameter(ParamID.LIMITER_THRESHOLD, 0, this.limiterThreshold);
+            this.queueParameter(ParamID.LIMITER_RELEASE, 0, this.limiterRelease);
 
             this.initialized = true;
 
-            this.port.postMessage({
-                type: 'wasm_initialized',
-                data: { success: true }
-            });
+            this.postLatency('wasm_initialized', { success: true });
 
             console.log('[MasteringProcessor] ✅ WASM engine initialized');
         } catch (error) {
@@ -121,6 +341,36 @@ class MasteringProcessor extends AudioWorkletProcessor {
         }
     }
 
+    // Queue a parameter change for the next block boundary. When the queue
+    // is full (an automation sweep outrunning the engine) only the latest
+    // value per (id, index) is kept and retried at the next process();
+    // while any are pending, new changes join them so none is overtaken
+    queueParameter(id, index, value) {
+        if (this.pendingParameters.size === 0 && this.commands.push(id, index, value)) return;
+        this.pendingParameters.set(id * PENDING_KEY_STRIDE + index, value);
+    }
+
+    flushPendingParameters() {
+        for (const [key, value] of this.pendingParameters) {
+            const id = Math.floor(key / PENDING_KEY_STRIDE);
+            if (!this.commands.push(id, key - id * PENDING_KEY_STRIDE, value)) return;
+            this.pendingParameters.delete(key);
+        }
+    }
+
+    // Input-to-output delay for A/B bypass alignment: the ring pre-fill plus
+    // the engine's own delay (limiter look-ahead + oversampler round trip)
+    latencySamples() {
+        return engineInstance.getStreamLatencySamples() + engineInstance.getLatencySamples();
+    }
+
+    postLatency(type, data = {}) {
+        this.port.postMessage({
+            type,
+            data: { ...data, latencySamples: this.latencySamples() }
+        });
+    }
+
     loadPreset(presetName) {
         if (!this.initialized) return;
 
@@ -209,11 +459,10 @@ class MasteringProcessor extends AudioWorkletProcessor {
         // Apply preset
         for (let i = 0; i < 7; i++) {
             this.eqGains[i] = gains[i];
+            this.queueParameter(ParamID.EQ_GAIN, i, gains[i]);
         }
         this.limiterThreshold = limiterThreshold;
-
-        engineInstance.setAllEQGains(gains);
-        engineInstance.setLimiterThreshold(limiterThreshold);
+        this.queueParameter(ParamID.LIMITER_THRESHOLD, 0, limiterThreshold);
 
         // Notify main thread
         this.port.postMessage({
@@ -258,19 +507,18 @@ class MasteringProcessor extends AudioWorkletProcessor {
 
         const numSamples = leftIn.length;
 
-        // Create interleaved stereo buffer for WASM
-        const interleavedInput = new Float32Array(numSamples * 2);
-        const interleavedOutput = new Float32Array(numSamples * 2);
-
-        // Interleave input (LRLRLR...)
-        for (let i = 0; i < numSamples; i++) {
-            interleavedInput[i * 2] = leftIn[i];
-            interleavedInput[i * 2 + 1] = rightIn[i];
-        }
-
-        // PROCESS THROUGH WASM ENGINE
+        // PROCESS THROUGH WASM ENGINE (quantum in, drain internal blocks, quantum out)
+        if (this.pendingParameters.size > 0) this.flushPendingParameters();
         try {
-            engineInstance.processBuffer(interleavedInput, interleavedOutput, numSamples);
+            if (!this.inputRing.write(leftIn, rightIn)) {
+                // Overrun: the engine fell behind and the input ring is full.
+                // Re-prime both rings so input and output line up again and
+                // keep this quantum rather than dropping it
+                this.overruns++;
+                engineInstance.resetStream(128);
+                this.inputRing.write(leftIn, rightIn);
+            }
+            engineInstance.processQueued();
         } catch (error) {
             console.error('[MasteringProcessor] WASM processing error:', error);
             // Fallback: pass through
@@ -279,30 +527,30 @@ class MasteringProcessor extends AudioWorkletProcessor {
             return true;
         }
 
-        // De-interleave output
-        for (let i = 0; i < numSamples; i++) {
-            leftOut[i] = interleavedOutput[i * 2];
-            rightOut[i] = interleavedOutput[i * 2 + 1];
+        if (!this.outputRing.read(leftOut, rightOut)) {
+            // Underrun: emit silence rather than stale samples
+            this.underruns++;
+            leftOut.fill(0);
+            rightOut.fill(0);
         }
 
         // Send metering data periodically
         this.meteringCounter += numSamples;
         if (this.meteringCounter >= this.meteringInterval) {
-            try {
-                const meteringData = {
-                    integratedLUFS: engineInstance.getIntegratedLUFS(),
-                    shortTermLUFS: engineInstance.getShortTermLUFS(),
-                    momentaryLUFS: engineInstance.getMomentaryLUFS(),
-                    phaseCorrelation: engineInstance.getPhaseCorrelation(),
-                    limiterGainReduction: engineInstance.getLimiterGainReduction()
-                };
-
+            const meteringData = this.meters.read();
+            if (meteringData) {
                 this.port.postMessage({
                     type: 'metering_update',
                     data: meteringData
                 });
-            } catch (error) {
-                console.error('[MasteringProcessor] Metering error:', error);
+            }
+
+            if (this.overruns + this.underruns !== this.reportedXruns) {
+                this.reportedXruns = this.overruns + this.underruns;
+                this.port.postMessage({
+                    type: 'stream_xrun',
+                    data: { overruns: this.overruns, underruns: this.underruns }
+                });
             }
 
             this.meteringCounter = 0;
@@ -0,0 +1,95 @@
+#!/usr/bin/env node
+/**
+ * processBuffer vs processBlock - Realtime Factor Benchmark
+ * Compares the legacy val-per-sample API with the zero-copy planar float32 API.
+ *
+ * Build first:  ./build-100-percent-ultimate.sh
+ * Run:          node benchmark-process-block.mjs [path/to/engine.js] [seconds]
+ */
+
+import { pathToFileURL } from 'node:url';
+import path from 'node:path';
+
+const modulePath = process.argv[2] || './build/mastering-engine-100-ultimate.js';
+const seconds = Number(process.argv[3] || 20);
+const SAMPLE_RATE = 48000;
+const QUANTUM = 128; // Web Audio render quantum
+
+const { default: createMasteringEngine } = await import(pathToFileURL(path.resolve(modulePath)).href);
+const Module = await createMasteringEngine();
+
+// ═══════════════════════════════════════════════════════════════════
+// Test signal: 110 Hz + 3.5 kHz with slow amplitude movement
+// ═══════════════════════════════════════════════════════════════════
+const totalFrames = seconds * SAMPLE_RATE;
+const left = new Float32Array(totalFrames);
+const right = new Float32Array(totalFrames);
+for (let i = 0; i < totalFrames; i++) {
+    const t = i / SAMPLE_RATE;
+    const env = 0.5 + 0.4 * Math.sin(2 * Math.PI * 0.25 * t);
+    left[i] = env * (0.6 * Math.sin(2 * Math.PI * 110 * t) + 0.2 * Math.sin(2 * Math.PI * 3500 * t));
+    right[i] = env * (0.6 * Math.sin(2 * Math.PI * 110 * t + 0.3) + 0.2 * Math.sin(2 * Math.PI * 3500 * t + 0.7));
+}
+
+function createEngine() {
+    const engine = new Module.MasteringEngine(SAMPLE_RATE);
+    engine.setAllEQGains([1.0, 1.5, -0.5, 0.5, 1.5, 2.0, 1.0]);
+    engine.setLimiterThreshold(-1.0);
+    return engine;
+}
+
+// Legacy path: exactly what MasteringProcessor.js did before processBlock()
+function runProcessBuffer() {
+    const engine = createEngine();
+    const start = performance.now();
+    for (let offset = 0; offset + QUANTUM <= totalFrames; offset += QUANTUM) {
+        const interleavedInput = new Float32Array(QUANTUM * 2);
+        const interleavedOutput = new Float32Array(QUANTUM * 2);
+        for (let i = 0; i < QUANTUM; i++) {
+            interleavedInput[i * 2] = left[offset + i];
+            interleavedInput[i * 2 + 1] = right[offset + i];
+        }
+        engine.processBuffer(interleavedInput, interleavedOutput, QUANTUM);
+    }
+    const elapsed = performance.now() - start;
+    engine.delete();
+    return elapsed;
+}
+
+// Zero-copy path: one HEAPF32.set per channel, one embind call per quantum
+function runProcessBlock() {
+    const engine = createEngine();
+    const leftPtr = engine.getLeftBufferPtr();
+    const rightPtr = engine.getRightBufferPtr();
+    const outL = new Float32Array(QUANTUM);
+    const outR = new Float32Array(QUANTUM);
+    let leftHeap = new Float32Array(Module.HEAPF32.buffer, leftPtr, QUANTUM);
+    let rightHeap = new Float32Array(Module.HEAPF32.buffer, rightPtr, QUANTUM);
+
+    const start = performance.now();
+    for (let offset = 0; offset + QUANTUM <= totalFrames; offset += QUANTUM) {
+        if (leftHeap.buffer !== Module.HEAPF32.buffer) {
+            leftHeap = new Float32Array(Module.HEAPF32.buffer, leftPtr, QUANTUM);
+            rightHeap = new Float32Array(Module.HEAPF32.buffer, rightPtr, QUANTUM);
+        }
+        leftHeap.set(left.subarray(offset, offset + QUANTUM));
+        rightHeap.set(right.subarray(offset, offset + QUANTUM));
+        engine.processBlock(leftPtr, rightPtr, QUANTUM);
+        outL.set(leftHeap);
+        outR.set(rightHeap);
+    }
+    const elapsed = performance.now() - start;
+    engine.delete();
+    return elapsed;
+}
+
+const audioMs = (totalFrames / SAMPLE_RATE) * 1000;
+const bufferMs = runProcessBuffer();
+const blockMs = runProcessBlock();
+
+console.log('═══════════════════════════════════════════════════════════════');
+console.log(`  MasteringEngine realtime factor (${seconds}s stereo @ ${SAMPLE_RATE} Hz, ${QUANTUM}-frame quanta)`);
+console.log('═══════════════════════════════════════════════════════════════');
+console.log(`  processBuffer (val):      ${bufferMs.toFixed(1).padStart(9)} ms   ${(audioMs / bufferMs).toFixed(1).padStart(7)}x realtime`);
+console.log(`  processBlock (HEAPF32):   ${blockMs.toFixed(1).padStart(9)} ms   ${(audioMs / blockMs).toFixed(1).padStart(7)}x realtime`);
+console.log(`  Speedup:                  ${(bufferMs / blockMs).toFixed(2)}x`);
@@ -54,7 +54,9 @@ echo "🔨 Compiling C++ → WebAssembly (100% ULTIMATE)..."
 echo ""
 
 # Compile with maximum optimization
-emcc MasteringEngine_100_PERCENT_ULTIMATE.cpp \
+# Embind adapter + the platform-independent DSP core (dsp/, also built
+# natively as libluvlang_dsp.a by CMakeLists.txt)
+emcc MasteringEngine_100_PERCENT_ULTIMATE.cpp dsp/MasteringEngine.cpp dsp/CpuDispatch.cpp \
     -o build/mastering-engine-100-ultimate.js \
     \
     `# C++ Standard and Optimization` \
@@ -66,12 +68,17 @@ emcc MasteringEngine_100_PERCENT_ULTIMATE.cpp \
     -msimd128 \
     -mrelaxed-simd \
     \
+    `# SharedArrayBuffer-backed memory for the lock-free audio rings` \
+    `# (needs COOP/COEP headers - already set in nginx.conf / _headers)` \
+    -s SHARED_MEMORY=1 \
+    \
     `# Emscripten Settings` \
     --bind \
     -s WASM=1 \
     -s MODULARIZE=1 \
     -s EXPORT_ES6=1 \
     -s EXPORT_NAME="createMasteringEngine" \
+    -s EXPORTED_RUNTIME_METHODS='["HEAPF32"]' \
     -s ALLOW_MEMORY_GROWTH=1 \
     -s INITIAL_MEMORY=16777216 \
     -s MAXIMUM_MEMORY=67108864 \
@@ -66,6 +66,7 @@ emcc MasteringEngine_ULTIMATE_LEGENDARY.cpp \
     -s MODULARIZE=1 \
     -s EXPORT_ES6=1 \
     -s EXPORT_NAME="createMasteringEngine" \
+    -s EXPORTED_RUNTIME_METHODS='["HEAPF32"]' \
     -s ALLOW_MEMORY_GROWTH=1 \
     -s INITIAL_MEMORY=16777216 \
     -s MAXIMUM_MEMORY=67108864 \
@@ -37,6 +37,7 @@ CFLAGS=(
     -s ALLOW_MEMORY_GROWTH=1         # Allow dynamic memory allocation
     -s MODULARIZE=1                  # Export as ES6 module
     -s EXPORT_NAME="createMasteringEngine"  # Module factory name
+    -s EXPORTED_RUNTIME_METHODS='["HEAPF32"]'  # Heap views for processBlock()
     -s ENVIRONMENT=web               # Web-only (not Node.js)
     -s MALLOC=emmalloc               # Lightweight allocator for audio
     -s INITIAL_MEMORY=16MB           # 16MB initial memory
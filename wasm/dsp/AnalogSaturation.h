@@ -0,0 +1,67 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Analog Saturation / Soft Clipper
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Drive-and-mix tanh saturation stage.
+ */
+
+#pragma once
+
+#include "DSPCommon.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ANALOG SATURATION / SOFT CLIPPER
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample>
+class AnalogSaturation {
+private:
+    double drive = 1.0;
+    double mix = 0.5;
+    ParameterSmoother driveSmoother;
+    ParameterSmoother mixSmoother;
+    double dcBlockerState = 0.0;  // Integrator stays double for any Sample
+    constexpr static double DC_COEFF = 0.995;
+
+public:
+    AnalogSaturation() {
+        driveSmoother.setImmediate(1.0);
+        mixSmoother.setImmediate(0.5);
+    }
+
+    void setSampleRate(double sr) {
+        driveSmoother.setSmoothTime(20.0, sr);
+        mixSmoother.setSmoothTime(20.0, sr);
+    }
+
+    void setDrive(double driveAmount) {
+        drive = std::max(1.0, std::min(4.0, driveAmount));
+        driveSmoother.setTarget(drive);
+    }
+
+    void setMix(double mixAmount) {
+        mix = std::max(0.0, std::min(1.0, mixAmount));
+        mixSmoother.setTarget(mix);
+    }
+
+    inline Sample process(Sample input) {
+        Sample smoothDrive = static_cast<Sample>(driveSmoother.getSmoothed());
+        Sample smoothMix = static_cast<Sample>(mixSmoother.getSmoothed());
+        Sample driven = input * smoothDrive;
+        Sample saturated = fastTanh(driven) / smoothDrive;
+        Sample blocked = static_cast<Sample>(saturated - dcBlockerState);
+        dcBlockerState = dcBlockerState * DC_COEFF + saturated * (1.0 - DC_COEFF);
+        return input * (Sample(1) - smoothMix) + blocked * smoothMix;
+    }
+
+    void processBlock(Sample* samples, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            samples[i] = process(samples[i]);
+        }
+    }
+
+    void reset() {
+        dcBlockerState = 0.0;
+    }
+};
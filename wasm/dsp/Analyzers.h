@@ -0,0 +1,136 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Crest Factor and Mix Health Analyzers
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Programme analysis used for metering and the AI auto-master.
+ */
+
+#pragma once
+
+#include "DSPCommon.h"
+
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CREST FACTOR ANALYZER
+// ═══════════════════════════════════════════════════════════════════════════
+
+class CrestFactorAnalyzer {
+private:
+    std::vector<double> rmsBuffer;
+    int rmsIndex;
+    int bufferSize;
+    double peakValue;
+    double rmsSum;
+
+public:
+    CrestFactorAnalyzer(int windowSamples = 4800)
+        : bufferSize(windowSamples), rmsIndex(0), peakValue(0.0), rmsSum(0.0) {
+        rmsBuffer.resize(bufferSize, 0.0);
+    }
+
+    void processSample(double left, double right) {
+        double peak = std::max(std::abs(left), std::abs(right));
+        peakValue = std::max(peakValue * 0.999, peak);
+
+        double meanSquare = (left * left + right * right) / 2.0;
+
+        rmsSum -= rmsBuffer[rmsIndex];
+        rmsBuffer[rmsIndex] = meanSquare;
+        rmsSum += meanSquare;
+
+        rmsIndex = (rmsIndex + 1) % bufferSize;
+    }
+
+    template <typename Sample>
+    void processBlock(const Sample* left, const Sample* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            processSample(left[i], right[i]);
+        }
+    }
+
+    double getCrestFactor() {
+        double rms = std::sqrt(rmsSum / bufferSize);
+        if (rms < 1e-10) return 100.0;
+        return linearToDb(peakValue / rms);
+    }
+
+    double getPeak() {
+        return linearToDb(peakValue);
+    }
+
+    double getRMS() {
+        return linearToDb(std::sqrt(rmsSum / bufferSize));
+    }
+
+    void reset() {
+        std::fill(rmsBuffer.begin(), rmsBuffer.end(), 0.0);
+        rmsIndex = 0;
+        peakValue = 0.0;
+        rmsSum = 0.0;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MIX HEALTH ANALYZER
+// ═══════════════════════════════════════════════════════════════════════════
+
+// lufsWarning points at a string literal: analyze() runs on the audio
+// thread, and assigning a std::string there can allocate (libc++ on wasm32
+// keeps only 10 characters inline)
+struct MixHealthReport {
+    bool clippingDetected = false;
+    bool phaseIssues = false;
+    const char* lufsWarning = "OK";
+    double peakDB = 0.0;
+    double phaseCorrelation = 0.0;
+    double integratedLUFS = -70.0;
+};
+
+class MixHealthAnalyzer {
+private:
+    bool clippingDetected = false;
+    bool phaseIssuesDetected = false;
+    const char* lufsWarning = "OK";
+    double peakSample = 0.0;
+    double phaseCorrelation = 0.0;
+    double lufs = -70.0;
+
+public:
+    void analyze(double peakDB, double phaseCorr, double integratedLUFS) {
+        peakSample = peakDB;
+        phaseCorrelation = phaseCorr;
+        lufs = integratedLUFS;
+
+        // Detect clipping
+        clippingDetected = (peakDB >= -0.1);
+
+        // Detect phase issues
+        phaseIssuesDetected = (phaseCorr < 0.3);  // Too narrow or out-of-phase
+
+        // LUFS warnings
+        if (lufs < -30.0) {
+            lufsWarning = "Way Too Quiet";
+        } else if (lufs < -20.0) {
+            lufsWarning = "Too Quiet";
+        } else if (lufs > -8.0) {
+            lufsWarning = "Way Too Loud";
+        } else if (lufs > -10.0) {
+            lufsWarning = "Too Loud";
+        } else {
+            lufsWarning = "OK";
+        }
+    }
+
+    MixHealthReport getReport() const {
+        MixHealthReport report;
+        report.clippingDetected = clippingDetected;
+        report.phaseIssues = phaseIssuesDetected;
+        report.lufsWarning = lufsWarning;
+        report.peakDB = peakSample;
+        report.phaseCorrelation = phaseCorrelation;
+        report.integratedLUFS = lufs;
+        return report;
+    }
+};
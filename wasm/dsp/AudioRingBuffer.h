@@ -0,0 +1,96 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Lock-Free SPSC Audio Ring Buffer
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Planar stereo FIFO shared between the AudioWorklet and the engine.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOCK-FREE SPSC AUDIO RING BUFFER (SharedArrayBuffer)
+// ═══════════════════════════════════════════════════════════════════════════
+// Planar stereo FIFO living in (shared) WASM memory. Exactly one producer and
+// one consumer; the worklet writes 128-frame quanta with Atomics on the header
+// while the engine drains larger internal blocks. Indices are free-running
+// uint32 counters and CAPACITY is a power of two, so wrap-around is a mask.
+//
+// Memory layout (read directly by MasteringProcessor.js):
+//   [0] writeIndex  [1] readIndex  [2] capacity  [3] reserved   (uint32)
+//   float32 left[CAPACITY], float32 right[CAPACITY]
+
+class AudioRingBuffer {
+public:
+    constexpr static uint32_t CAPACITY = 4096;  // frames per channel
+    constexpr static uint32_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "capacity must be a power of two");
+
+private:
+    std::atomic<uint32_t> writeIndex{0};
+    std::atomic<uint32_t> readIndex{0};
+    uint32_t capacity = CAPACITY;
+    uint32_t reserved = 0;
+    std::array<float, CAPACITY> dataL{};
+    std::array<float, CAPACITY> dataR{};
+
+public:
+    uint32_t availableRead() const {
+        return writeIndex.load(std::memory_order_acquire) -
+               readIndex.load(std::memory_order_relaxed);
+    }
+
+    uint32_t availableWrite() const {
+        return CAPACITY - (writeIndex.load(std::memory_order_relaxed) -
+                           readIndex.load(std::memory_order_acquire));
+    }
+
+    // Producer side
+    uint32_t write(const float* left, const float* right, uint32_t numFrames) {
+        uint32_t w = writeIndex.load(std::memory_order_relaxed);
+        numFrames = std::min(numFrames, availableWrite());
+        for (uint32_t i = 0; i < numFrames; ++i) {
+            dataL[(w + i) & MASK] = left[i];
+            dataR[(w + i) & MASK] = right[i];
+        }
+        writeIndex.store(w + numFrames, std::memory_order_release);
+        return numFrames;
+    }
+
+    uint32_t writeSilence(uint32_t numFrames) {
+        uint32_t w = writeIndex.load(std::memory_order_relaxed);
+        numFrames = std::min(numFrames, availableWrite());
+        for (uint32_t i = 0; i < numFrames; ++i) {
+            dataL[(w + i) & MASK] = 0.0f;
+            dataR[(w + i) & MASK] = 0.0f;
+        }
+        writeIndex.store(w + numFrames, std::memory_order_release);
+        return numFrames;
+    }
+
+    // Consumer side
+    uint32_t read(float* left, float* right, uint32_t numFrames) {
+        uint32_t r = readIndex.load(std::memory_order_relaxed);
+        numFrames = std::min(numFrames, availableRead());
+        for (uint32_t i = 0; i < numFrames; ++i) {
+            left[i] = dataL[(r + i) & MASK];
+            right[i] = dataR[(r + i) & MASK];
+        }
+        readIndex.store(r + numFrames, std::memory_order_release);
+        return numFrames;
+    }
+
+    // Only safe while neither side is running
+    void reset() {
+        writeIndex.store(0, std::memory_order_relaxed);
+        readIndex.store(0, std::memory_order_relaxed);
+    }
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "ring indices must be lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "JS reads indices as uint32");
@@ -0,0 +1,106 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Compile-Time Math
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * constexpr sin / cos / tan / sqrt / integer power for generating filter
+ * tables at compile time (the <cmath> functions are not constexpr in
+ * C++17). Only meant for table generation: every call is a loop of plain
+ * double arithmetic, accurate to a few ulp over the argument ranges the
+ * filter designs use (|x| up to a few hundred radians), and far too slow
+ * for the sample path.
+ */
+
+#pragma once
+
+namespace ConstexprMath {
+
+constexpr double HALF_PI_HI = 1.57079632679489655800;   // pi/2 rounded to double
+constexpr double HALF_PI_LO = 6.12323399573676603587e-17;  // pi/2 - HALF_PI_HI
+
+constexpr double abs(double x) {
+    return x < 0.0 ? -x : x;
+}
+
+// Taylor series on |r| <= pi/4, summed until the terms vanish
+constexpr double sinKernel(double r) {
+    double r2 = r * r;
+    double term = r;
+    double sum = r;
+    for (int n = 1; n < 20; ++n) {
+        term *= -r2 / ((2 * n) * (2 * n + 1));
+        double next = sum + term;
+        if (next == sum) break;
+        sum = next;
+    }
+    return sum;
+}
+
+constexpr double cosKernel(double r) {
+    double r2 = r * r;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= -r2 / ((2 * n - 1) * (2 * n));
+        double next = sum + term;
+        if (next == sum) break;
+        sum = next;
+    }
+    return sum;
+}
+
+// x = k pi/2 + r with |r| <= pi/4; pi/2 is split in two so r keeps full
+// precision (Cody-Waite), then the quadrant picks the kernel and sign
+constexpr double sin(double x) {
+    double kf = x / HALF_PI_HI;
+    long long k = static_cast<long long>(kf < 0.0 ? kf - 0.5 : kf + 0.5);
+    double r = (x - k * HALF_PI_HI) - k * HALF_PI_LO;
+    switch (static_cast<int>(k & 3)) {
+        case 0:  return sinKernel(r);
+        case 1:  return cosKernel(r);
+        case 2:  return -sinKernel(r);
+        default: return -cosKernel(r);
+    }
+}
+
+constexpr double cos(double x) {
+    double kf = x / HALF_PI_HI;
+    long long k = static_cast<long long>(kf < 0.0 ? kf - 0.5 : kf + 0.5);
+    double r = (x - k * HALF_PI_HI) - k * HALF_PI_LO;
+    switch (static_cast<int>(k & 3)) {
+        case 0:  return cosKernel(r);
+        case 1:  return -sinKernel(r);
+        case 2:  return -cosKernel(r);
+        default: return sinKernel(r);
+    }
+}
+
+constexpr double tan(double x) {
+    return sin(x) / cos(x);
+}
+
+// Newton's method from above (max(1, x) >= sqrt(x)): the iterates fall
+// monotonically, so stop as soon as one fails to
+constexpr double sqrt(double x) {
+    if (x <= 0.0) return 0.0;
+    double guess = x < 1.0 ? 1.0 : x;
+    for (int i = 0; i < 2000; ++i) {
+        double next = 0.5 * (guess + x / guess);
+        if (next >= guess) break;
+        guess = next;
+    }
+    return guess;
+}
+
+// x^n by repeated squaring
+constexpr double powInt(double x, int n) {
+    double result = 1.0;
+    double base = x;
+    for (unsigned e = static_cast<unsigned>(n); e != 0; e >>= 1) {
+        if (e & 1) result *= base;
+        base *= base;
+    }
+    return result;
+}
+
+}  // namespace ConstexprMath
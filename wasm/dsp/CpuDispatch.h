@@ -0,0 +1,97 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Runtime CPU Dispatch
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * One binary, several instruction sets: the kernels in DSPKernels.h are
+ * compiled once for the build's baseline target and again, on x86-64, as
+ * AVX2 and AVX-512 variants (CpuDispatch.cpp). The best variant the CPU
+ * supports is chosen once, on first use, and every later call goes
+ * through that table.
+ *
+ *   baseline  the build's -march: SSE2 for portable x86-64 builds, NEON on
+ *             aarch64, simd128 under Emscripten
+ *   avx2      256-bit: two FIR phases / two downsampling partial sums
+ *             per instruction, 4-wide dB conversions
+ *   avx512    512-bit: four downsampling partial sums per instruction,
+ *             8-wide conversions (upsampling reuses the AVX2 kernels)
+ *
+ * All variants give bit-identical results (see DSPKernels.h), so a render
+ * farm mixing CPU generations produces the same files everywhere. Keep
+ * LUVLANG_NATIVE_ARCH off (the default) for such binaries so the code
+ * outside these kernels stays on the baseline; the LUVLANG_CPU_ISA
+ * environment variable (baseline / avx2 / avx512) caps the choice for
+ * testing.
+ */
+
+#pragma once
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INSTRUCTION SET VARIANTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+enum CpuIsa {
+    CPU_ISA_BASELINE = 0,
+    CPU_ISA_AVX2,
+    CPU_ISA_AVX512,
+    CPU_ISA_COUNT
+};
+
+using GainKernelF64 = void (*)(const double* input, double* output, int numSamples);
+using GainKernelF32 = void (*)(const float* input, float* output, int numSamples);
+using DitherKernelF64 = void (*)(double* samples, const double* tpdf, int numSamples, double scale, double lsb);
+using FIRKernelF64 = void (*)(const double* history, const double* taps, double* output);
+
+// Kernel entry points. FIR entries are indexed by log2(factor) - 1
+// (2x, 4x, 8x) and cover the 16-taps-per-phase quality tiers.
+struct DSPKernelTable {
+    CpuIsa isa;
+    const char* name;
+
+    GainKernelF64 linearToDbF64;
+    GainKernelF32 linearToDbF32;
+    GainKernelF64 dbToLinearF64;
+    GainKernelF32 dbToLinearF32;
+
+    DitherKernelF64 ditherQuantizeF64;
+
+    FIRKernelF64 firUpsampleF64[3];
+    FIRKernelF64 firDownsampleF64[3];
+};
+
+const char* cpuIsaName(CpuIsa isa);
+
+// Best variant this CPU and OS can run
+CpuIsa detectCpuIsa();
+
+// The variant's table, or nullptr if it was not compiled in or this CPU
+// cannot run it
+const DSPKernelTable* dspKernelVariant(CpuIsa isa);
+
+// The active table: detectCpuIsa(), capped by LUVLANG_CPU_ISA if set
+const DSPKernelTable& dspKernels();
+
+// Switch the active table (benchmarks and tests). Objects that cached
+// entry points at construction keep the old ones. Returns false if the
+// variant is unavailable.
+bool selectDSPKernels(CpuIsa isa);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TYPED WRAPPERS (gain computers)
+// ═══════════════════════════════════════════════════════════════════════════
+
+inline void dispatchLinearToDb(const double* input, double* output, int numSamples) {
+    dspKernels().linearToDbF64(input, output, numSamples);
+}
+
+inline void dispatchLinearToDb(const float* input, float* output, int numSamples) {
+    dspKernels().linearToDbF32(input, output, numSamples);
+}
+
+inline void dispatchDbToLinear(const double* input, double* output, int numSamples) {
+    dspKernels().dbToLinearF64(input, output, numSamples);
+}
+
+inline void dispatchDbToLinear(const float* input, float* output, int numSamples) {
+    dspKernels().dbToLinearF32(input, output, numSamples);
+}
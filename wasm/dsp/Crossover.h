@@ -0,0 +1,103 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Linkwitz-Riley Crossovers
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * 4th-order LR crossover and the 3-band splitter built from it. Both are
+ * stereo: L/R run as one SIMD lane pair through StereoZDFBiquad.
+ */
+
+#pragma once
+
+#include "ZDFBiquad.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LINKWITZ-RILEY 4TH-ORDER CROSSOVER
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample>
+class LinkwitzRileyCrossover {
+private:
+    using Pair = StereoPair<Sample>;
+
+    StereoZDFBiquad<Sample> lowpass1, lowpass2;
+    StereoZDFBiquad<Sample> highpass1, highpass2;
+    double crossoverFreq;
+    double sampleRate;
+
+public:
+    LinkwitzRileyCrossover(double freq = 500.0, double sr = 48000.0)
+        : crossoverFreq(freq), sampleRate(sr) {
+        updateCoefficients();
+    }
+
+    void setSampleRate(double sr) {
+        sampleRate = sr;
+        updateCoefficients();
+    }
+
+    void setCrossoverFrequency(double freq) {
+        crossoverFreq = freq;
+        updateCoefficients();
+    }
+
+    void updateCoefficients() {
+        double Q = 0.707;
+        lowpass1.setSampleRate(sampleRate);
+        lowpass2.setSampleRate(sampleRate);
+        highpass1.setSampleRate(sampleRate);
+        highpass2.setSampleRate(sampleRate);
+        lowpass1.setCoefficients(crossoverFreq, Q, 0.0, ZDFDesign::LOWPASS);
+        lowpass2.setCoefficients(crossoverFreq, Q, 0.0, ZDFDesign::LOWPASS);
+        highpass1.setCoefficients(crossoverFreq, Q, 0.0, ZDFDesign::HIGHPASS);
+        highpass2.setCoefficients(crossoverFreq, Q, 0.0, ZDFDesign::HIGHPASS);
+    }
+
+    void process(Pair input, Pair& low, Pair& high) {
+        low = lowpass2.process(lowpass1.process(input));
+        high = highpass2.process(highpass1.process(input));
+    }
+
+    void reset() {
+        lowpass1.reset(); lowpass2.reset();
+        highpass1.reset(); highpass2.reset();
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 3-BAND LINKWITZ-RILEY CROSSOVER
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample>
+class ThreeBandCrossover {
+private:
+    using Pair = StereoPair<Sample>;
+
+    LinkwitzRileyCrossover<Sample> lowMidCrossover;
+    LinkwitzRileyCrossover<Sample> midHighCrossover;
+
+public:
+    ThreeBandCrossover(double lowMid = 250.0, double midHigh = 2000.0, double sr = 48000.0)
+        : lowMidCrossover(lowMid, sr), midHighCrossover(midHigh, sr) {}
+
+    void setSampleRate(double sr) {
+        lowMidCrossover.setSampleRate(sr);
+        midHighCrossover.setSampleRate(sr);
+    }
+
+    void setFrequencies(double lowMid, double midHigh) {
+        lowMidCrossover.setCrossoverFrequency(lowMid);
+        midHighCrossover.setCrossoverFrequency(midHigh);
+    }
+
+    void process(Pair input, Pair& low, Pair& mid, Pair& high) {
+        Pair midHigh;
+        lowMidCrossover.process(input, low, midHigh);
+        midHighCrossover.process(midHigh, mid, high);
+    }
+
+    void reset() {
+        lowMidCrossover.reset();
+        midHighCrossover.reset();
+    }
+};
@@ -0,0 +1,155 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - DSP Common (constants, utilities, smoothing, DC filter)
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Shared building blocks for every stage of the mastering chain.
+ * Header-only, no platform dependencies. Sample-path helpers come in float
+ * and double so the chain can run in either precision (MasteringEngineT).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONSTANTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double SQRT2 = 1.41421356237309504880;
+constexpr double MAX_SAMPLE_RATE = 192000.0;   // Delay lines are preallocated for this rate
+constexpr double DEFAULT_LOOKAHEAD_MS = 50.0;  // Limiter look-ahead
+constexpr double MAX_LOOKAHEAD_MS = 50.0;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// UTILITY FUNCTIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+inline double dbToLinear(double db) {
+    return std::pow(10.0, db / 20.0);
+}
+
+inline float dbToLinear(float db) {
+    return std::pow(10.0f, db / 20.0f);
+}
+
+inline double linearToDb(double linear) {
+    return 20.0 * std::log10(std::max(linear, 1e-10));
+}
+
+inline float linearToDb(float linear) {
+    return 20.0f * std::log10(std::max(linear, 1e-10f));
+}
+
+template <typename Sample>
+inline Sample fastTanh(Sample x) {
+    if (x < Sample(-3.0)) return Sample(-1.0);
+    if (x > Sample(3.0)) return Sample(1.0);
+    return x * (Sample(27.0) + x * x) / (Sample(27.0) + Sample(9.0) * x * x);
+}
+
+// Hard-clip function for "Safe-Clip" mode
+template <typename Sample>
+inline Sample hardClip(Sample x, Sample ceiling) {
+    if (x > ceiling) return ceiling;
+    if (x < -ceiling) return -ceiling;
+    return x;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PARAMETER SMOOTHER (Prevents Zipper Noise)
+// ═══════════════════════════════════════════════════════════════════════════
+
+class ParameterSmoother {
+private:
+    double target = 0.0;
+    double current = 0.0;
+    double smoothCoeff = 0.0;
+    // Snap to the target once this close, so consumers can tell the ramp
+    // has ended (the exponential approach otherwise never gets there)
+    constexpr static double SETTLE_THRESHOLD = 1e-6;
+
+public:
+    ParameterSmoother(double smoothTimeMs = 20.0, double sampleRate = 48000.0) {
+        setSmoothTime(smoothTimeMs, sampleRate);
+    }
+
+    void setSmoothTime(double smoothTimeMs, double sampleRate) {
+        smoothCoeff = std::exp(-1.0 / (smoothTimeMs * 0.001 * sampleRate));
+    }
+
+    void setTarget(double newValue) {
+        target = newValue;
+    }
+
+    void setImmediate(double newValue) {
+        target = newValue;
+        current = newValue;
+    }
+
+    inline double getSmoothed() {
+        current = target + smoothCoeff * (current - target);
+        if (std::abs(current - target) < SETTLE_THRESHOLD) current = target;
+        return current;
+    }
+
+    // Step several samples at once for control-rate consumers
+    double advance(int samples) {
+        for (int i = 0; i < samples; ++i) {
+            getSmoothed();
+        }
+        return current;
+    }
+
+    bool isSettled() const {
+        return current == target;
+    }
+
+    void reset() {
+        current = target;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DC OFFSET FILTER (Essential for Clean Headroom)
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Integrator state stays double in both precisions: at a ~1Hz corner a
+// float state would quantize the very offset it is tracking
+
+template <typename Sample>
+class DCOffsetFilter {
+private:
+    double state = 0.0;
+    constexpr static double COEFF = 0.999;  // ~1Hz highpass
+    bool enabled = true;
+
+public:
+    void setEnabled(bool enable) {
+        enabled = enable;
+    }
+
+    inline Sample process(Sample input) {
+        if (!enabled) return input;
+
+        // First-order highpass filter @ ~1Hz
+        double output = input - state;
+        state = state * COEFF + input * (1.0 - COEFF);
+        return static_cast<Sample>(output);
+    }
+
+    void processBlock(Sample* samples, int numSamples) {
+        if (!enabled) return;
+        for (int i = 0; i < numSamples; ++i) {
+            double input = samples[i];
+            samples[i] = static_cast<Sample>(input - state);
+            state = state * COEFF + input * (1.0 - COEFF);
+        }
+    }
+
+    void reset() {
+        state = 0.0;
+    }
+};
@@ -0,0 +1,105 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Portable DSP Kernels
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * The array-shaped inner loops that CpuDispatch.h can swap for wider ISA
+ * variants: dB conversions for the gain computers, the flat-TPDF quantiser,
+ * and the oversampler FIR bank. These bodies are the baseline variant
+ * (SSE2 / NEON / simd128 through the lane-pair types, depending on the
+ * build's target) and define the reference arithmetic: every wider variant
+ * performs the same IEEE operations in the same order per output, so all
+ * variants produce bit-identical results.
+ */
+
+#pragma once
+
+#include "FastMath.h"
+#include "SIMD.h"
+
+#include <cmath>
+
+namespace DSPKernels {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// GAIN COMPUTER dB CONVERSIONS (may run in place)
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample>
+LUVLANG_KERNEL_INLINE void linearToDb(const Sample* input, Sample* output, int numSamples) {
+    linearToDbBlock(input, output, numSamples);
+}
+
+template <typename Sample>
+LUVLANG_KERNEL_INLINE void dbToLinear(const Sample* input, Sample* output, int numSamples) {
+    dbToLinearBlock(input, output, numSamples);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FLAT TPDF QUANTISER
+// ═══════════════════════════════════════════════════════════════════════════
+// Round to nearest (ties to even) with the 1.5 * 2^52 shifter, exact for
+// |x| < 2^51: plain add/subtract, so the loop vectorizes on every ISA
+// (std::round / trunc / floor keep it scalar under IEEE semantics).
+
+LUVLANG_KERNEL_INLINE double roundToNearest(double x) {
+    const double shifter = 6755399441055744.0;
+    return (x + shifter) - shifter;
+}
+
+// samples[i] = round((samples[i] + tpdf[i] * lsb) * scale) * lsb
+LUVLANG_KERNEL_INLINE void ditherQuantize(double* samples, const double* tpdf, int numSamples,
+                                          double scale, double lsb) {
+    for (int i = 0; i < numSamples; ++i) {
+        samples[i] = roundToNearest((samples[i] + tpdf[i] * lsb) * scale) * lsb;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OVERSAMPLER FIR BANK (interleaved L/R)
+// ═══════════════════════════════════════════════════════════════════════════
+// history holds L/R pairs, newest first. Tap tables store every tap twice
+// (once per lane):
+//   upsample    taps[(k * Factor + phase) * 2 + lane]
+//   downsample  taps[j * 2 + lane]
+// Upsampling sums each phase over k in order. Downsampling keeps four
+// partial sums (taps j = m mod 4) and adds them as (s0 + s1) + (s2 + s3),
+// which breaks the dependency chain on every ISA and maps directly onto
+// one 512-bit or two 256-bit accumulators.
+
+template <typename Sample, int Factor, int TapsPerPhase>
+LUVLANG_KERNEL_INLINE void firUpsample(const StereoPair<Sample>* history, const Sample* taps,
+                                       StereoPair<Sample>* output) {
+    using Pair = StereoPair<Sample>;
+    Pair sum[Factor];
+    for (int phase = 0; phase < Factor; ++phase) {
+        sum[phase] = history[0] * Pair::broadcast(taps[phase * 2]);
+    }
+    for (int k = 1; k < TapsPerPhase; ++k) {
+        const Sample* t = taps + k * Factor * 2;
+        for (int phase = 0; phase < Factor; ++phase) {
+            sum[phase] = sum[phase] + history[k] * Pair::broadcast(t[phase * 2]);
+        }
+    }
+    for (int phase = 0; phase < Factor; ++phase) {
+        output[phase] = sum[phase];
+    }
+}
+
+template <typename Sample, int TapCount>
+LUVLANG_KERNEL_INLINE StereoPair<Sample> firDownsample(const StereoPair<Sample>* history, const Sample* taps) {
+    using Pair = StereoPair<Sample>;
+    static_assert(TapCount % 4 == 0, "four partial sums");
+    Pair sum[4];
+    for (int m = 0; m < 4; ++m) {
+        sum[m] = history[m] * Pair::broadcast(taps[m * 2]);
+    }
+    for (int j = 4; j < TapCount; j += 4) {
+        for (int m = 0; m < 4; ++m) {
+            sum[m] = sum[m] + history[j + m] * Pair::broadcast(taps[(j + m) * 2]);
+        }
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+}  // namespace DSPKernels
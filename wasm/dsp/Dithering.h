@@ -0,0 +1,253 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - TPDF Dithering with Noise Shaping
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Bit-depth reduction with triangular-PDF dither and optional error-feedback
+ * noise shaping. The dither and the quantiser run in double; only the
+ * result is stored as Sample. Random numbers come from xoshiro128++ run as
+ * interleaved lanes (one independent stream per channel), refilled a pool
+ * at a time so the generator vectorizes.
+ */
+
+#pragma once
+
+#include "CpuDispatch.h"
+#include "DSPCommon.h"
+#include "DSPKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DITHER RANDOM SOURCE (xoshiro128++, LANES interleaved generators)
+// ═══════════════════════════════════════════════════════════════════════════
+// Each lane is a full xoshiro128++ state; a refill steps every lane
+// POOL / LANES times with the state held lane-wise, so the compiler turns
+// each step into a handful of 128-bit integer ops. Streams are seeded
+// through splitmix64, so neighbouring stream IDs are uncorrelated.
+
+class DitherRandom {
+public:
+    constexpr static int LANES = 4;
+    constexpr static int POOL = 64;
+
+private:
+    static_assert(POOL % LANES == 0, "pool must hold whole lane steps");
+
+    uint32_t s0[LANES], s1[LANES], s2[LANES], s3[LANES];
+    std::array<uint32_t, POOL> pool;
+    int next = POOL;
+
+    static inline uint32_t rotl(uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    static uint64_t splitMix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    void refill() {
+        for (int base = 0; base < POOL; base += LANES) {
+            for (int lane = 0; lane < LANES; ++lane) {
+                pool[base + lane] = rotl(s0[lane] + s3[lane], 7) + s0[lane];
+                uint32_t t = s1[lane] << 9;
+                s2[lane] ^= s0[lane];
+                s3[lane] ^= s1[lane];
+                s1[lane] ^= s2[lane];
+                s0[lane] ^= s3[lane];
+                s2[lane] ^= t;
+                s3[lane] = rotl(s3[lane], 11);
+            }
+        }
+        next = 0;
+    }
+
+public:
+    explicit DitherRandom(uint64_t stream = 0) {
+        seed(stream);
+    }
+
+    void seed(uint64_t stream) {
+        uint64_t x = 12345 + stream * 0x632be59bd9b4e019ULL;
+        for (int lane = 0; lane < LANES; ++lane) {
+            uint64_t a = splitMix64(x);
+            uint64_t b = splitMix64(x);
+            s0[lane] = static_cast<uint32_t>(a);
+            s1[lane] = static_cast<uint32_t>(a >> 32);
+            s2[lane] = static_cast<uint32_t>(b);
+            s3[lane] = static_cast<uint32_t>(b >> 32) | 1u;  // Never all-zero
+        }
+        next = POOL;
+    }
+
+    // Uniform in [-0.5, 0.5)
+    inline double uniform() {
+        if (next == POOL) refill();
+        return static_cast<int32_t>(pool[next++]) * (1.0 / 4294967296.0);
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DITHERING (TPDF + ERROR-FEEDBACK NOISE SHAPING)
+// ═══════════════════════════════════════════════════════════════════════════
+// With e[n] the total error (output minus shaped input, dither included),
+//   y[n] = Q(x[n] - sum h[k] e[n-1-k] + d[n])
+// so the output noise is e filtered by NTF(z) = 1 - sum h[k] z^-(k+1):
+//   FLAT        no feedback: plain TPDF, 0.5 LSB rms
+//   F_WEIGHTED  Wannamaker's 9-tap F-weighted curve: about -24 dB at 3-4 kHz,
+//               where hearing is most sensitive, rising to +27 dB at
+//               Nyquist (designed for 44.1 kHz; close enough at 48 kHz)
+//   HIGH_PASS   first-order 1 - z^-1: 6 dB/octave tilt towards Nyquist
+
+enum NoiseShaping {
+    NOISE_SHAPING_FLAT = 0,
+    NOISE_SHAPING_F_WEIGHTED,
+    NOISE_SHAPING_HIGH_PASS
+};
+
+template <typename Sample>
+class Dithering {
+private:
+    constexpr static int MAX_TAPS = 9;
+
+    DitherRandom random;
+    uint64_t stream;
+    int targetBits = 16;
+    double scale = 32768.0;       // 2^(bits - 1)
+    double lsb = 1.0 / 32768.0;
+    bool enabled = false;
+
+    NoiseShaping shaping = NOISE_SHAPING_FLAT;
+    std::array<double, MAX_TAPS> shapingCoeffs{};
+    int shapingTaps = 0;
+    std::array<double, 2 * MAX_TAPS> errorHistory{};  // Stored twice: e[k] = error k+1 samples ago
+    int errorIndex = 0;
+
+    DitherKernelF64 quantizeKernel = dspKernels().ditherQuantizeF64;
+
+    // TAPS is a template parameter so the feedback sum fully unrolls
+    template <int TAPS>
+    inline double quantize(double input) {
+        // Older taps first, newest error last: only one multiply-subtract
+        // sits on the sample-to-sample feedback path
+        const double* e = &errorHistory[errorIndex];
+        double feedback = 0.0;
+        for (int k = TAPS - 1; k > 0; --k) {
+            feedback += shapingCoeffs[k] * e[k];
+        }
+        double shaped = (TAPS > 0) ? input - (feedback + shapingCoeffs[0] * e[0]) : input;
+
+        double tpdf = random.uniform() + random.uniform();  // [-1, 1) LSB
+        double quantized = DSPKernels::roundToNearest((shaped + tpdf * lsb) * scale) * lsb;
+
+        if (TAPS > 0) {
+            errorIndex = (errorIndex == 0) ? MAX_TAPS - 1 : errorIndex - 1;
+            errorHistory[errorIndex] = quantized - shaped;
+            errorHistory[errorIndex + MAX_TAPS] = quantized - shaped;
+        }
+        return quantized;
+    }
+
+    inline double quantize(double input) {
+        switch (shapingTaps) {
+            case MAX_TAPS: return quantize<MAX_TAPS>(input);
+            case 1:        return quantize<1>(input);
+            default:       return quantize<0>(input);
+        }
+    }
+
+    template <int TAPS>
+    void quantizeBlock(Sample* samples, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            samples[i] = static_cast<Sample>(quantize<TAPS>(samples[i]));
+        }
+    }
+
+    // Flat TPDF has no feedback: draw a pool's worth of dither, then
+    // quantise it as one vector pass (the dispatched kernel in double)
+    void quantizeBlockFlat(Sample* samples, int numSamples) {
+        double tpdf[DitherRandom::POOL];
+        for (int offset = 0; offset < numSamples; offset += DitherRandom::POOL) {
+            const int count = std::min(DitherRandom::POOL, numSamples - offset);
+            for (int i = 0; i < count; ++i) {
+                tpdf[i] = random.uniform() + random.uniform();
+            }
+            Sample* block = samples + offset;
+            if constexpr (std::is_same_v<Sample, double>) {
+                quantizeKernel(block, tpdf, count, scale, lsb);
+            } else {
+                for (int i = 0; i < count; ++i) {
+                    block[i] = static_cast<Sample>(
+                        DSPKernels::roundToNearest((block[i] + tpdf[i] * lsb) * scale) * lsb);
+                }
+            }
+        }
+    }
+
+public:
+    // Each channel gets its own stream so L/R dither is uncorrelated
+    explicit Dithering(uint64_t streamId = 0) : random(streamId), stream(streamId) {}
+
+    void setEnabled(bool enable) {
+        enabled = enable;
+    }
+
+    void setTargetBits(int bits) {
+        targetBits = std::max(8, std::min(24, bits));
+        scale = static_cast<double>(1 << (targetBits - 1));
+        lsb = 1.0 / scale;
+    }
+
+    void setNoiseShaping(NoiseShaping mode) {
+        static const double F_WEIGHTED[MAX_TAPS] = {
+            2.412, -3.370, 3.937, -4.174, 3.353, -2.205, 1.281, -0.569, 0.0847
+        };
+        shaping = mode;
+        shapingCoeffs.fill(0.0);
+        switch (mode) {
+            case NOISE_SHAPING_F_WEIGHTED:
+                std::copy(F_WEIGHTED, F_WEIGHTED + MAX_TAPS, shapingCoeffs.begin());
+                shapingTaps = MAX_TAPS;
+                break;
+            case NOISE_SHAPING_HIGH_PASS:
+                shapingCoeffs[0] = 1.0;
+                shapingTaps = 1;
+                break;
+            default:
+                shaping = NOISE_SHAPING_FLAT;
+                shapingTaps = 0;
+                break;
+        }
+        errorHistory.fill(0.0);
+    }
+
+    NoiseShaping getNoiseShaping() const {
+        return shaping;
+    }
+
+    inline Sample process(Sample input) {
+        if (!enabled) return input;
+        return static_cast<Sample>(quantize(input));
+    }
+
+    void processBlock(Sample* samples, int numSamples) {
+        if (!enabled) return;
+        switch (shapingTaps) {
+            case MAX_TAPS: quantizeBlock<MAX_TAPS>(samples, numSamples); break;
+            case 1:        quantizeBlock<1>(samples, numSamples); break;
+            default:       quantizeBlockFlat(samples, numSamples); break;
+        }
+    }
+
+    void reset() {
+        random.seed(stream);
+        errorHistory.fill(0.0);
+        errorIndex = 0;
+    }
+};
@@ -0,0 +1,341 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - De-Esser and Multiband Compressor
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Frequency-selective dynamics ahead of the limiter. The gain computers
+ * convert levels with the FastMath.h polynomials rather than libm.
+ */
+
+#pragma once
+
+#include "CpuDispatch.h"
+#include "Crossover.h"
+#include "FastMath.h"
+#include "ZDFBiquad.h"
+
+#include <array>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// INTELLIGENT DE-ESSER / HIGH-FREQUENCY LIMITER
+// ═══════════════════════════════════════════════════════════════════════════
+// Tames sibilance and harshness in the 8-12kHz range
+// Professional mastering essential for tracks with boosted highs
+// processBlock() runs detection, the dB conversions and the gain curve as
+// separate passes over a chunk, so the conversions vectorize; only the
+// filter and the envelope follower are serial
+
+template <typename Sample>
+class DeEsser {
+private:
+    constexpr static int CHUNK = 256;
+
+    ZDFBiquad<Sample> sibilanceDetector;  // Bandpass @ 8-12kHz
+    Sample threshold;                     // dB
+    Sample ratio;
+    Sample attackCoeff;
+    Sample releaseCoeff;
+    Sample envelope;
+    bool enabled;
+
+    // Static curve: dB of gain (<= 0) for a detector level in dB
+    inline Sample gainDB(Sample levelDB) const {
+        return -std::max(Sample(0), levelDB - threshold) * (Sample(1) - Sample(1) / ratio);
+    }
+
+    inline Sample follow(Sample targetGain) {
+        Sample coeff = (targetGain < envelope) ? attackCoeff : releaseCoeff;
+        envelope = targetGain + coeff * (envelope - targetGain);
+        return envelope;
+    }
+
+public:
+    DeEsser() : threshold(-20.0), ratio(4.0), envelope(1.0), enabled(false) {
+        // Bandpass filter centered at 10kHz for sibilance detection
+        sibilanceDetector.setCoefficients(10000.0, 2.0, 0.0, ZDFDesign::BANDPASS);
+        setAttack(0.001);   // 1ms attack (very fast)
+        setRelease(0.02);   // 20ms release
+    }
+
+    void setSampleRate(double sr) {
+        sibilanceDetector.setSampleRate(sr);
+        setAttack(0.001, sr);
+        setRelease(0.02, sr);
+    }
+
+    void setEnabled(bool enable) {
+        enabled = enable;
+    }
+
+    void setThreshold(double thresholdDB) {
+        threshold = static_cast<Sample>(thresholdDB);
+    }
+
+    void setRatio(double r) {
+        ratio = static_cast<Sample>(std::max(1.0, std::min(10.0, r)));
+    }
+
+    void setAttack(double attackSec, double sampleRate = 48000.0) {
+        attackCoeff = static_cast<Sample>(std::exp(-1.0 / (attackSec * sampleRate)));
+    }
+
+    void setRelease(double releaseSec, double sampleRate = 48000.0) {
+        releaseCoeff = static_cast<Sample>(std::exp(-1.0 / (releaseSec * sampleRate)));
+    }
+
+    inline Sample process(Sample input) {
+        if (!enabled) return input;
+
+        // Detect sibilance energy
+        Sample sibilanceSignal = sibilanceDetector.process(input);
+        Sample sibilanceDB = fastLinearToDb(std::abs(sibilanceSignal));
+
+        // Gain reduction only on sibilance, then the envelope follower
+        Sample targetGain = fastDbToLinear(gainDB(sibilanceDB));
+
+        // Apply gain reduction to entire signal
+        return input * follow(targetGain);
+    }
+
+    // Same arithmetic as process(), pass by pass
+    void processBlock(Sample* samples, int numSamples) {
+        if (!enabled) return;
+        Sample level[CHUNK];
+        for (int start = 0; start < numSamples; start += CHUNK) {
+            Sample* x = samples + start;
+            int count = std::min(CHUNK, numSamples - start);
+
+            for (int i = 0; i < count; ++i) {
+                level[i] = std::abs(sibilanceDetector.process(x[i]));
+            }
+            dispatchLinearToDb(level, level, count);
+            for (int i = 0; i < count; ++i) {
+                level[i] = gainDB(level[i]);
+            }
+            dispatchDbToLinear(level, level, count);
+            for (int i = 0; i < count; ++i) {
+                x[i] = x[i] * follow(level[i]);
+            }
+        }
+    }
+
+    double getGainReduction() {
+        return linearToDb(static_cast<double>(envelope));
+    }
+
+    void reset() {
+        sibilanceDetector.reset();
+        envelope = 1;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MULTIBAND COMPRESSOR
+// ═══════════════════════════════════════════════════════════════════════════
+// Three LR4 bands, each with a log-domain feed-forward compressor. Per
+// chunk of CHUNK frames, every band runs as separate passes:
+//   1. detector level (|x|, or max(|L|, |R|) when stereo-linked)
+//   2. level -> dB                          (vectorized, FastMath.h)
+//   3. static curve: threshold, ratio, knee (vectorized, branch-free)
+//   4. attack/release on the gain in dB     (scalar recursion)
+//   5. dB -> gain, applied to the band      (vectorized)
+// Linked bands share one detector and envelope, so the stereo image holds
+// still under compression; unlinked, each channel has its own.
+
+template <typename Sample>
+class MultibandCompressor {
+private:
+    constexpr static int BANDS = 3;
+    constexpr static int CHUNK = 256;
+
+    using Pair = StereoPair<Sample>;
+
+    ThreeBandCrossover<Sample> crossover;
+
+    struct BandCompressor {
+        Sample threshold = -20;  // dB
+        Sample ratio = 4;
+        Sample knee = 6;         // dB, full width around the threshold
+        Sample attackCoeff;
+        Sample releaseCoeff;
+        Sample envelope[2] = {0, 0};  // Smoothed gain (dB, <= 0); [1] unused when linked
+
+        BandCompressor() {
+            setAttack(0.01);
+            setRelease(0.1);
+        }
+
+        void setAttack(double attackSec, double sampleRate = 48000.0) {
+            attackCoeff = static_cast<Sample>(std::exp(-1.0 / (attackSec * sampleRate)));
+        }
+
+        void setRelease(double releaseSec, double sampleRate = 48000.0) {
+            releaseCoeff = static_cast<Sample>(std::exp(-1.0 / (releaseSec * sampleRate)));
+        }
+
+        // Gain (dB) for a detector level (dB): 0 below the knee, quadratic
+        // through it, (1/ratio - 1) * overshoot above. Branch-free:
+        //   kneeOver = clamp(over + knee/2, 0, knee)
+        //   gain = slope * (kneeOver^2 / (2 knee) + max(over - knee/2, 0))
+        inline Sample gainDB(Sample levelDB, Sample slope, Sample halfKnee, Sample kneeScale) const {
+            Sample over = levelDB - threshold;
+            Sample kneeOver = std::min(std::max(over + halfKnee, Sample(0)), knee);
+            return slope * (kneeOver * kneeOver * kneeScale + std::max(over - halfKnee, Sample(0)));
+        }
+
+        // Level (linear) in, gain (linear) out, over one detector
+        void computeGain(Sample* level, int count, Sample& state) const {
+            const Sample slope = Sample(1) / ratio - Sample(1);
+            const Sample halfKnee = knee * Sample(0.5);
+            const Sample kneeScale = knee > Sample(0) ? Sample(0.5) / knee : Sample(0);
+
+            dispatchLinearToDb(level, level, count);
+            for (int i = 0; i < count; ++i) {
+                level[i] = gainDB(level[i], slope, halfKnee, kneeScale);
+            }
+            Sample env = state;
+            for (int i = 0; i < count; ++i) {
+                Sample coeff = (level[i] < env) ? attackCoeff : releaseCoeff;
+                env = level[i] + coeff * (env - level[i]);
+                level[i] = env;
+            }
+            state = env;
+            dispatchDbToLinear(level, level, count);
+        }
+
+        void process(Sample* left, Sample* right, int count, bool linked) {
+            Sample gainL[CHUNK];
+            Sample gainR[CHUNK];
+            if (linked) {
+                for (int i = 0; i < count; ++i) {
+                    gainL[i] = std::max(std::abs(left[i]), std::abs(right[i]));
+                }
+                computeGain(gainL, count, envelope[0]);
+                for (int i = 0; i < count; ++i) {
+                    left[i] = left[i] * gainL[i];
+                    right[i] = right[i] * gainL[i];
+                }
+            } else {
+                for (int i = 0; i < count; ++i) {
+                    gainL[i] = std::abs(left[i]);
+                    gainR[i] = std::abs(right[i]);
+                }
+                computeGain(gainL, count, envelope[0]);
+                computeGain(gainR, count, envelope[1]);
+                for (int i = 0; i < count; ++i) {
+                    left[i] = left[i] * gainL[i];
+                    right[i] = right[i] * gainR[i];
+                }
+            }
+        }
+
+        void reset() {
+            envelope[0] = 0;
+            envelope[1] = 0;
+        }
+    };
+
+    std::array<BandCompressor, BANDS> bands;  // 0 low, 1 mid, 2 high
+    bool enabled;
+    bool stereoLink = true;
+
+public:
+    MultibandCompressor() : enabled(false) {}
+
+    void setSampleRate(double sr) {
+        crossover.setSampleRate(sr);
+        bands[0].setAttack(0.01, sr);
+        bands[0].setRelease(0.1, sr);
+        bands[1].setAttack(0.005, sr);
+        bands[1].setRelease(0.08, sr);
+        bands[2].setAttack(0.003, sr);
+        bands[2].setRelease(0.05, sr);
+    }
+
+    void setEnabled(bool enable) {
+        enabled = enable;
+    }
+
+    void setLowBand(double threshold, double ratio) {
+        setBandThreshold(0, threshold);
+        setBandRatio(0, ratio);
+    }
+
+    void setMidBand(double threshold, double ratio) {
+        setBandThreshold(1, threshold);
+        setBandRatio(1, ratio);
+    }
+
+    void setHighBand(double threshold, double ratio) {
+        setBandThreshold(2, threshold);
+        setBandRatio(2, ratio);
+    }
+
+    // band: 0 = low, 1 = mid, 2 = high
+    void setBandThreshold(int band, double threshold) {
+        if (band >= 0 && band < BANDS) bands[band].threshold = static_cast<Sample>(threshold);
+    }
+
+    void setBandRatio(int band, double ratio) {
+        if (band >= 0 && band < BANDS) bands[band].ratio = static_cast<Sample>(std::max(1.0, ratio));
+    }
+
+    void setBandKnee(int band, double kneeDB) {
+        if (band >= 0 && band < BANDS) bands[band].knee = static_cast<Sample>(std::max(0.0, kneeDB));
+    }
+
+    // true: one detector per band driven by max(|L|, |R|)
+    void setStereoLink(bool linked) {
+        if (linked != stereoLink) {
+            // Both detectors pick up from the more compressed one
+            for (auto& band : bands) {
+                Sample shared = std::min(band.envelope[0], band.envelope[1]);
+                band.envelope[0] = shared;
+                band.envelope[1] = shared;
+            }
+        }
+        stereoLink = linked;
+    }
+
+    // A one-frame block: same passes, same arithmetic as processBlock()
+    void processStereo(Sample& left, Sample& right) {
+        processBlock(&left, &right, 1);
+    }
+
+    void processBlock(Sample* left, Sample* right, int numSamples) {
+        if (!enabled) return;
+        Sample split[BANDS][2][CHUNK];  // [band][channel][frame]
+        for (int start = 0; start < numSamples; start += CHUNK) {
+            Sample* l = left + start;
+            Sample* r = right + start;
+            int count = std::min(CHUNK, numSamples - start);
+
+            for (int i = 0; i < count; ++i) {
+                Pair low, mid, high;
+                crossover.process(Pair(l[i], r[i]), low, mid, high);
+                split[0][0][i] = low.left();
+                split[0][1][i] = low.right();
+                split[1][0][i] = mid.left();
+                split[1][1][i] = mid.right();
+                split[2][0][i] = high.left();
+                split[2][1][i] = high.right();
+            }
+
+            for (int b = 0; b < BANDS; ++b) {
+                bands[b].process(split[b][0], split[b][1], count, stereoLink);
+            }
+
+            for (int i = 0; i < count; ++i) {
+                l[i] = split[0][0][i] + split[1][0][i] + split[2][0][i];
+                r[i] = split[0][1][i] + split[1][1][i] + split[2][1][i];
+            }
+        }
+    }
+
+    void reset() {
+        crossover.reset();
+        for (auto& band : bands) {
+            band.reset();
+        }
+    }
+};
@@ -0,0 +1,224 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - 7-Band EQ and High-Frequency Air Protection
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Mastering EQ bank and the 12-20kHz soft limiter that follows it.
+ */
+
+#pragma once
+
+#include "ZDFBiquad.h"
+
+#include <array>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 7-BAND PARAMETRIC EQ (Professional Mastering Grade)
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Stereo: one smoother and coefficient set per band drives both channels.
+// Centre frequencies and Q never change, so each band is designed once per
+// sample rate; only the BELL gain term m1 = k(A^2 - 1) follows the gain.
+// While a gain is ramping, m1 is recomputed every CONTROL_INTERVAL samples
+// and linearly interpolated in between; once the smoother settles the band
+// runs with frozen coefficients.
+
+template <typename Sample>
+class SevenBandEQ {
+private:
+    constexpr static int BANDS = 7;
+    constexpr static double BAND_Q = 0.707;
+    constexpr static int CONTROL_INTERVAL = 32;
+
+    struct Band {
+        ParameterSmoother gain;
+        double m1 = 0.0;            // Gain term in use
+        double m1Step = 0.0;        // Per-sample increment across the chunk
+        double m1ChunkEnd = 0.0;    // Exact value the chunk lands on
+        int rampRemaining = 0;      // Samples left in the current chunk
+    };
+
+    using Pair = StereoPair<Sample>;
+
+    std::array<StereoZDFBiquad<Sample>, BANDS> filters;
+    std::array<Band, BANDS> bands;
+    double k = 1.0 / BAND_Q;
+
+    const std::array<double, 7> centerFreqs = {
+        40.0, 120.0, 350.0, 1000.0, 3500.0, 8000.0, 14000.0
+    };
+
+    // Same expression ZDFDesign::design() uses for BELL
+    double bellGainTerm(double gainDB) const {
+        double A = dbToLinear(gainDB);
+        return k * (A * A - 1.0);
+    }
+
+    void designBands() {
+        for (int i = 0; i < BANDS; ++i) {
+            filters[i].setCoefficients(centerFreqs[i], BAND_Q, 0.0, ZDFDesign::BELL);
+            filters[i].setMixCoefficients(1.0, bands[i].m1, 0.0);
+        }
+    }
+
+    // Start the next control chunk; false once the band's gain has settled
+    inline bool beginChunk(Band& band) {
+        if (band.gain.isSettled()) return false;
+        band.m1ChunkEnd = bellGainTerm(band.gain.advance(CONTROL_INTERVAL));
+        band.m1Step = (band.m1ChunkEnd - band.m1) / CONTROL_INTERVAL;
+        band.rampRemaining = CONTROL_INTERVAL;
+        return true;
+    }
+
+    inline void stepRamp(Band& band, StereoZDFBiquad<Sample>& filter) {
+        band.m1 = (--band.rampRemaining == 0) ? band.m1ChunkEnd : band.m1 + band.m1Step;
+        filter.setMixCoefficients(1.0, band.m1, 0.0);
+    }
+
+public:
+    SevenBandEQ() {
+        designBands();
+    }
+
+    void setSampleRate(double sr) {
+        for (auto& filter : filters) {
+            filter.setSampleRate(sr);
+        }
+        for (auto& band : bands) {
+            band.gain.setSmoothTime(20.0, sr);
+        }
+        designBands();
+    }
+
+    void setBandGain(int band, double gainDB) {
+        if (band >= 0 && band < BANDS) {
+            bands[band].gain.setTarget(gainDB);
+        }
+    }
+
+    void setAllGains(const std::array<double, 7>& gains) {
+        for (int i = 0; i < BANDS; ++i) {
+            setBandGain(i, gains[i]);
+        }
+    }
+
+    inline void processStereo(Sample& left, Sample& right) {
+        Pair output(left, right);
+        for (int i = 0; i < BANDS; ++i) {
+            if (bands[i].rampRemaining > 0 || beginChunk(bands[i])) {
+                stepRamp(bands[i], filters[i]);
+            }
+            output = filters[i].process(output);
+        }
+        left = output.left();
+        right = output.right();
+    }
+
+    // Band by band over the block: ramp chunks sample by sample, then the
+    // steady remainder in one fixed-coefficient pass. Matches processStereo()
+    void processBlock(Sample* left, Sample* right, int numSamples) {
+        for (int b = 0; b < BANDS; ++b) {
+            StereoZDFBiquad<Sample>& filter = filters[b];
+            Band& band = bands[b];
+            int i = 0;
+            while (i < numSamples) {
+                if (band.rampRemaining == 0 && !beginChunk(band)) {
+                    filter.processBlock(left + i, right + i, numSamples - i);
+                    break;
+                }
+                int end = std::min(numSamples, i + band.rampRemaining);
+                for (; i < end; ++i) {
+                    stepRamp(band, filter);
+                    Pair output = filter.process(Pair(left[i], right[i]));
+                    left[i] = output.left();
+                    right[i] = output.right();
+                }
+            }
+        }
+    }
+
+    bool isSettled() const {
+        for (const auto& band : bands) {
+            if (band.rampRemaining > 0 || !band.gain.isSettled()) return false;
+        }
+        return true;
+    }
+
+    void reset() {
+        for (auto& filter : filters) {
+            filter.reset();
+        }
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HIGH-FREQUENCY AIR PROTECTION
+// ═══════════════════════════════════════════════════════════════════════════
+// Prevents harsh square waves when users aggressively boost the 14kHz "Air" band
+// Uses soft clipping on high frequencies (12-20kHz) before saturation stage
+// Stereo: both channels share one filter pair
+
+template <typename Sample>
+class HighFrequencyProtection {
+private:
+    using Pair = StereoPair<Sample>;
+
+    StereoZDFBiquad<Sample> hpFilter;  // Highpass @ 12kHz to isolate air frequencies
+    StereoZDFBiquad<Sample> lpFilter;  // Lowpass @ 12kHz for low/mid frequencies
+    Sample threshold;                  // Soft clip threshold (linear)
+    bool enabled;
+
+    // Fast tanh approximation for soft clipping
+    inline Sample fastTanh(Sample x) {
+        if (x > Sample(3.0)) return Sample(1.0);
+        if (x < Sample(-3.0)) return Sample(-1.0);
+        Sample x2 = x * x;
+        return x * (Sample(27.0) + x2) / (Sample(27.0) + Sample(9.0) * x2);
+    }
+
+public:
+    HighFrequencyProtection() : threshold(Sample(0.9)), enabled(true) {
+        hpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFDesign::HIGHPASS);
+        lpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFDesign::LOWPASS);
+    }
+
+    void setSampleRate(double sr) {
+        hpFilter.setSampleRate(sr);
+        lpFilter.setSampleRate(sr);
+        hpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFDesign::HIGHPASS);
+        lpFilter.setCoefficients(12000.0, 0.707, 0.0, ZDFDesign::LOWPASS);
+    }
+
+    void setEnabled(bool en) {
+        enabled = en;
+    }
+
+    void setThreshold(double thresholdLinear) {
+        threshold = static_cast<Sample>(std::max(0.5, std::min(1.0, thresholdLinear)));
+    }
+
+    inline void processStereo(Sample& left, Sample& right) {
+        if (!enabled) return;
+
+        // Split into high and low/mid frequencies
+        Pair input(left, right);
+        Pair highFreq = hpFilter.process(input);
+        Pair lowMid = lpFilter.process(input);
+
+        // Apply gentle soft clipping to high frequencies only, then recombine
+        left = lowMid.left() + fastTanh(highFreq.left() / threshold) * threshold;
+        right = lowMid.right() + fastTanh(highFreq.right() / threshold) * threshold;
+    }
+
+    void processBlock(Sample* left, Sample* right, int numSamples) {
+        if (!enabled) return;
+        for (int i = 0; i < numSamples; ++i) {
+            processStereo(left[i], right[i]);
+        }
+    }
+
+    void reset() {
+        hpFilter.reset();
+        lpFilter.reset();
+    }
+};
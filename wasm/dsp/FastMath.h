@@ -0,0 +1,191 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Fast log2 / exp2 and dB Conversion Kernels
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Polynomial replacements for log10/pow in the per-sample gain computers,
+ * accurate to well under 0.001 dB over the whole -120..+24 dB range (see
+ * tools/benchmark_fastmath.cpp). Every function is branch-free IEEE
+ * arithmetic plus integer bit manipulation, so the block kernels are plain
+ * loops the compiler vectorizes (SSE/AVX natively, simd128 under
+ * Emscripten) and give exactly the same results as the scalar calls.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// Block kernels are forced inline so each CpuDispatch.cpp ISA variant gets
+// its own vectorized copy instead of a call into the baseline one
+#if defined(__GNUC__) || defined(__clang__)
+#define LUVLANG_KERNEL_INLINE inline __attribute__((always_inline))
+#else
+#define LUVLANG_KERNEL_INLINE inline
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOG2
+// ═══════════════════════════════════════════════════════════════════════════
+// x = 2^e * m with m in [sqrt(1/2), sqrt(2)), found by subtracting the bit
+// pattern of sqrt(1/2) and keeping the exponent field. With
+// s = (m - 1) / (m + 1), |s| <= 0.172 and
+//   ln(m) = 2 (s + s^3/3 + s^5/5 + s^7/7 + ...)
+// so four terms leave a truncation error below 3e-8. Inputs must be
+// positive and normal; callers clamp first.
+
+namespace FastMathDetail {
+
+template <typename Sample>
+inline Sample logMantissa(Sample m) {
+    Sample s = (m - Sample(1)) / (m + Sample(1));
+    Sample s2 = s * s;
+    Sample series = Sample(1) + s2 * (Sample(1.0 / 3.0) + s2 * (Sample(1.0 / 5.0) + s2 * Sample(1.0 / 7.0)));
+    return Sample(2.0 / 0.69314718055994530942) * s * series;  // log2(m)
+}
+
+}  // namespace FastMathDetail
+
+inline double fastLog2(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    uint64_t offset = bits - 0x3fe6a09e667f3bcdULL;  // sqrt(1/2)
+    int64_t exponent = static_cast<int64_t>(offset) >> 52;
+    uint64_t mantissaBits = bits - (static_cast<uint64_t>(exponent) << 52);
+    double m;
+    std::memcpy(&m, &mantissaBits, sizeof(m));
+
+    // exponent -> double through the 1.5 * 2^52 bit pattern (exact for any
+    // exponent); a plain int64 conversion would block vectorization below
+    // AVX-512DQ
+    uint64_t exponentBits = 0x4338000000000000ULL + static_cast<uint64_t>(exponent);
+    double e;
+    std::memcpy(&e, &exponentBits, sizeof(e));
+    return (e - 6755399441055744.0) + FastMathDetail::logMantissa(m);
+}
+
+inline float fastLog2(float x) {
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    uint32_t offset = bits - 0x3f3504f3U;  // sqrt(1/2)
+    int32_t exponent = static_cast<int32_t>(offset) >> 23;
+    uint32_t mantissaBits = bits - (static_cast<uint32_t>(exponent) << 23);
+    float m;
+    std::memcpy(&m, &mantissaBits, sizeof(m));
+    return static_cast<float>(exponent) + FastMathDetail::logMantissa(m);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EXP2
+// ═══════════════════════════════════════════════════════════════════════════
+// x = n + f with n = round(x), |f| <= 1/2. Adding 1.5 * 2^52 (2^23 for
+// float) rounds to the nearest integer and leaves n in the low mantissa
+// bits, so shifting that bit pattern up to the exponent field scales the
+// polynomial by 2^n without a float-to-int conversion. 2^f is the degree-6
+// Taylor series of e^(f ln 2): truncation error below 1.3e-7.
+
+namespace FastMathDetail {
+
+template <typename Sample>
+inline Sample expFraction(Sample f) {
+    const Sample c1 = Sample(0.69314718055994530942);
+    const Sample c2 = Sample(0.24022650695910071233);
+    const Sample c3 = Sample(0.05550410866482157995);
+    const Sample c4 = Sample(0.00961812910762847716);
+    const Sample c5 = Sample(0.00133335581464284434);
+    const Sample c6 = Sample(0.00015403530393381609);
+    return Sample(1) + f * (c1 + f * (c2 + f * (c3 + f * (c4 + f * (c5 + f * c6)))));
+}
+
+}  // namespace FastMathDetail
+
+namespace FastMathDetail {
+
+// Range clamps, kept apart from the polynomial so the block kernels can
+// run them as a separate (vectorizable) pass
+inline double clampExp2(double x) {
+    return std::min(std::max(x, -1022.0), 1023.0);
+}
+
+inline float clampExp2(float x) {
+    return std::min(std::max(x, -126.0f), 127.0f);
+}
+
+// 2^x for x already inside the clamp range
+inline double exp2Core(double x) {
+    const double shifter = 6755399441055744.0;  // 1.5 * 2^52
+    double rounded = x + shifter;
+    double n = rounded - shifter;
+    double p = expFraction(x - n);
+
+    uint64_t roundedBits, pBits;
+    std::memcpy(&roundedBits, &rounded, sizeof(roundedBits));
+    std::memcpy(&pBits, &p, sizeof(pBits));
+    pBits += roundedBits << 52;
+    std::memcpy(&p, &pBits, sizeof(p));
+    return p;
+}
+
+inline float exp2Core(float x) {
+    const float shifter = 12582912.0f;  // 1.5 * 2^23
+    float rounded = x + shifter;
+    float n = rounded - shifter;
+    float p = expFraction(x - n);
+
+    uint32_t roundedBits, pBits;
+    std::memcpy(&roundedBits, &rounded, sizeof(roundedBits));
+    std::memcpy(&pBits, &p, sizeof(pBits));
+    pBits += roundedBits << 23;
+    std::memcpy(&p, &pBits, sizeof(p));
+    return p;
+}
+
+}  // namespace FastMathDetail
+
+inline double fastExp2(double x) {
+    return FastMathDetail::exp2Core(FastMathDetail::clampExp2(x));
+}
+
+inline float fastExp2(float x) {
+    return FastMathDetail::exp2Core(FastMathDetail::clampExp2(x));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// dB CONVERSION (drop-in for linearToDb / dbToLinear on the sample path)
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample>
+inline Sample fastLinearToDb(Sample linear) {
+    // 20 log10(x) = 20 log10(2) log2(x); same 1e-10 floor as linearToDb()
+    return Sample(6.02059991327962390427) * fastLog2(std::max(linear, Sample(1e-10)));
+}
+
+template <typename Sample>
+inline Sample fastDbToLinear(Sample db) {
+    // 10^(dB/20) = 2^(dB log2(10) / 20)
+    return fastExp2(db * Sample(0.16609640474436811739));
+}
+
+// Block kernels: out[i] = f(in[i]); in-place is fine. The clamp runs as
+// its own pass: merged into the polynomial loop, the compare-and-select
+// stays a branch (IEEE trapping semantics) and the loop does not vectorize
+template <typename Sample>
+LUVLANG_KERNEL_INLINE void linearToDbBlock(const Sample* input, Sample* output, int numSamples) {
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] = std::max(input[i], Sample(1e-10));
+    }
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] = Sample(6.02059991327962390427) * fastLog2(output[i]);
+    }
+}
+
+template <typename Sample>
+LUVLANG_KERNEL_INLINE void dbToLinearBlock(const Sample* input, Sample* output, int numSamples) {
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] = FastMathDetail::clampExp2(input[i] * Sample(0.16609640474436811739));
+    }
+    for (int i = 0; i < numSamples; ++i) {
+        output[i] = FastMathDetail::exp2Core(output[i]);
+    }
+}
@@ -0,0 +1,261 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Half-Band IIR Oversampler
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Low-latency alternative to the polyphase FIR oversampler: cascaded 2x
+ * stages, each a pair of first-order allpass chains (the polyphase form of
+ * an elliptic half-band lowpass). Minimum phase rather than linear phase,
+ * in exchange for a few samples of delay and a fraction of the arithmetic.
+ */
+
+#pragma once
+
+#include "ConstexprMath.h"
+#include "DSPCommon.h"
+#include "SIMD.h"
+
+#include <array>
+#include <cmath>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HALF-BAND ALLPASS COEFFICIENT DESIGN
+// ═══════════════════════════════════════════════════════════════════════════
+// Elliptic half-band design for a given number of allpass coefficients and
+// transition bandwidth (normalised to the oversampled rate, passband edge at
+// 0.25 - transition), evaluated at compile time through ConstexprMath.h.
+// Coefficients are sorted ascending; even-indexed ones form branch A,
+// odd-indexed ones branch B, and
+//   H(z) = 1/2 (A(z^2) + z^-1 B(z^2))
+
+struct HalfBandDesign {
+    template <int Count>
+    constexpr static std::array<double, Count> computeCoefficients(double transition) {
+        double k = ConstexprMath::tan((1.0 - transition * 2.0) * PI / 4.0);
+        k *= k;
+        double kksqrt = ConstexprMath::sqrt(ConstexprMath::sqrt(1.0 - k * k));
+        double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        double e4 = e * e * e * e;
+        double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+        std::array<double, Count> coefs{};
+        int order = Count * 2 + 1;
+        for (int i = 0; i < Count; ++i) {
+            double c = i + 1;
+
+            // Jacobi theta series, truncated once the terms vanish
+            double num = 0.0;
+            double term = 0.0;
+            int sign = 1;
+            for (int j = 0; ; ++j, sign = -sign) {
+                term = ConstexprMath::powInt(q, j * (j + 1)) * ConstexprMath::sin((j * 2 + 1) * c * PI / order) * sign;
+                num += term;
+                if (ConstexprMath::abs(term) <= 1e-100) break;
+            }
+            num *= ConstexprMath::sqrt(ConstexprMath::sqrt(q));
+
+            double den = 0.5;
+            sign = -1;
+            for (int j = 1; ; ++j, sign = -sign) {
+                term = ConstexprMath::powInt(q, j * j) * ConstexprMath::cos(j * 2 * c * PI / order) * sign;
+                den += term;
+                if (ConstexprMath::abs(term) <= 1e-100) break;
+            }
+
+            double ww = num / den;
+            double wwsq = ww * ww;
+            double x = ConstexprMath::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+            coefs[i] = (1.0 - x) / (1.0 + x);
+        }
+        return coefs;
+    }
+
+    // Low-frequency group delay of one first-order section (c + z^-1)/(1 + c z^-1)
+    constexpr static double sectionDelay(double c) {
+        return (1.0 - c) / (1.0 + c);
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HALF-BAND 2X STAGE (stereo lane pair)
+// ═══════════════════════════════════════════════════════════════════════════
+// Upsampling feeds the input through both branches: A gives the first
+// output, B the second. Downsampling runs the odd input through A and the
+// even input through B and averages. Each branch section is
+//   y[n] = c (x[n] - y[n-1]) + x[n-1]
+// at the stage's input rate. Up and down keep separate section states.
+
+template <typename Sample, int Coefs>
+class HalfBandStage {
+public:
+    using Pair = StereoPair<Sample>;
+
+private:
+    struct SectionState {
+        std::array<Pair, Coefs> x1;
+        std::array<Pair, Coefs> y1;
+    };
+
+    std::array<Pair, Coefs> coefs;
+    SectionState upState;
+    SectionState downState;
+    Pair half = Pair::broadcast(Sample(0.5));
+    double roundTripDelay = 0.0;  // At this stage's input rate
+
+    inline static Pair section(Pair input, Pair c, Pair& x1, Pair& y1) {
+        Pair output = c * (input - y1) + x1;
+        x1 = input;
+        y1 = output;
+        return output;
+    }
+
+public:
+    void setCoefficients(const std::array<double, Coefs>& c) {
+        roundTripDelay = 0.0;
+        for (int i = 0; i < Coefs; ++i) {
+            coefs[i] = Pair::broadcast(static_cast<Sample>(c[i]));
+            roundTripDelay += HalfBandDesign::sectionDelay(c[i]);
+        }
+        reset();
+    }
+
+    // Low-frequency group delay of upsample() followed by downsample()
+    double getRoundTripDelay() const { return roundTripDelay; }
+
+    // One input frame in, two frames out (oldest first)
+    inline void upsample(Pair input, Pair& first, Pair& second) {
+        Pair a = input;
+        Pair b = input;
+        for (int i = 0; i < Coefs; i += 2) {
+            a = section(a, coefs[i], upState.x1[i], upState.y1[i]);
+        }
+        for (int i = 1; i < Coefs; i += 2) {
+            b = section(b, coefs[i], upState.x1[i], upState.y1[i]);
+        }
+        first = a;
+        second = b;
+    }
+
+    // Two frames in (oldest first), one frame out
+    inline Pair downsample(Pair first, Pair second) {
+        Pair a = second;
+        Pair b = first;
+        for (int i = 0; i < Coefs; i += 2) {
+            a = section(a, coefs[i], downState.x1[i], downState.y1[i]);
+        }
+        for (int i = 1; i < Coefs; i += 2) {
+            b = section(b, coefs[i], downState.x1[i], downState.y1[i]);
+        }
+        return half * (a + b);
+    }
+
+    void reset() {
+        upState.x1.fill(Pair());
+        upState.y1.fill(Pair());
+        downState.x1.fill(Pair());
+        downState.y1.fill(Pair());
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HALF-BAND IIR OVERSAMPLER (2x / 4x / 8x cascade)
+// ═══════════════════════════════════════════════════════════════════════════
+// Same upsample()/downsample() frame interface as Oversampler. The first
+// stage carries the steep transition (passband to ~20 kHz at 48 kHz, images
+// down ~75 dB); later stages run at higher rates where the band to protect
+// is relatively narrower, so they get by with fewer sections. At 4x that is
+// 12 allpass sections per input frame against the FIR's 128 taps.
+//
+// The phase response is not linear, so the round trip is not a whole
+// number of samples; getLatencySamples() reports the low-frequency group
+// delay rounded to the nearest sample.
+
+template <typename Sample, int Factor>
+class HalfBandOversampler {
+public:
+    using Pair = StereoPair<Sample>;
+    using Frame = std::array<Pair, Factor>;
+
+private:
+    static_assert(Factor == 1 || Factor == 2 || Factor == 4 || Factor == 8,
+                  "half-band cascade supports 1x, 2x, 4x and 8x");
+
+    HalfBandStage<Sample, 6> stage1;  // 1x -> 2x
+    HalfBandStage<Sample, 3> stage2;  // 2x -> 4x
+    HalfBandStage<Sample, 2> stage3;  // 4x -> 8x
+    double groupDelay = 0.0;
+
+public:
+    // Designed at compile time; the constructor only broadcasts them
+    constexpr static std::array<double, 6> STAGE1_COEFS = HalfBandDesign::computeCoefficients<6>(0.0417);
+    constexpr static std::array<double, 3> STAGE2_COEFS = HalfBandDesign::computeCoefficients<3>(0.146);
+    constexpr static std::array<double, 2> STAGE3_COEFS = HalfBandDesign::computeCoefficients<2>(0.198);
+
+    HalfBandOversampler() {
+        stage1.setCoefficients(STAGE1_COEFS);
+        stage2.setCoefficients(STAGE2_COEFS);
+        stage3.setCoefficients(STAGE3_COEFS);
+
+        // Stage s runs at 2^s times the input rate
+        if (Factor >= 2) groupDelay += stage1.getRoundTripDelay();
+        if (Factor >= 4) groupDelay += stage2.getRoundTripDelay() / 2.0;
+        if (Factor >= 8) groupDelay += stage3.getRoundTripDelay() / 4.0;
+    }
+
+    // Low-frequency group delay of upsample() followed by downsample(), in input samples
+    double getGroupDelay() const { return groupDelay; }
+
+    int getLatencySamples() const { return static_cast<int>(std::lround(groupDelay)); }
+
+    // One input frame in, Factor frames out (oldest first)
+    inline void upsample(Pair input, Frame& output) {
+        if constexpr (Factor == 1) {
+            output[0] = input;
+        } else if constexpr (Factor == 2) {
+            stage1.upsample(input, output[0], output[1]);
+        } else {
+            Pair twice[2];
+            stage1.upsample(input, twice[0], twice[1]);
+            if constexpr (Factor == 4) {
+                stage2.upsample(twice[0], output[0], output[1]);
+                stage2.upsample(twice[1], output[2], output[3]);
+            } else {
+                Pair fourTimes[4];
+                stage2.upsample(twice[0], fourTimes[0], fourTimes[1]);
+                stage2.upsample(twice[1], fourTimes[2], fourTimes[3]);
+                for (int i = 0; i < 4; ++i) {
+                    stage3.upsample(fourTimes[i], output[2 * i], output[2 * i + 1]);
+                }
+            }
+        }
+    }
+
+    // Factor frames in (oldest first), one frame out
+    inline Pair downsample(const Frame& input) {
+        if constexpr (Factor == 1) {
+            return input[0];
+        } else if constexpr (Factor == 2) {
+            return stage1.downsample(input[0], input[1]);
+        } else {
+            Pair twice[2];
+            if constexpr (Factor == 4) {
+                twice[0] = stage2.downsample(input[0], input[1]);
+                twice[1] = stage2.downsample(input[2], input[3]);
+            } else {
+                Pair fourTimes[4];
+                for (int i = 0; i < 4; ++i) {
+                    fourTimes[i] = stage3.downsample(input[2 * i], input[2 * i + 1]);
+                }
+                twice[0] = stage2.downsample(fourTimes[0], fourTimes[1]);
+                twice[1] = stage2.downsample(fourTimes[2], fourTimes[3]);
+            }
+            return stage1.downsample(twice[0], twice[1]);
+        }
+    }
+
+    void reset() {
+        stage1.reset();
+        stage2.reset();
+        stage3.reset();
+    }
+};
@@ -0,0 +1,190 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - EBU R128 LUFS Meter
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * K-weighted momentary, short-term, integrated loudness and LRA, all
+ * built from 100ms sub-block energies. Always measures in double, whatever
+ * sample type the chain runs in.
+ */
+
+#pragma once
+
+#include "LoudnessHistogram.h"
+#include "ZDFBiquad.h"
+
+#include <array>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EBU R128 LUFS METER
+// ═══════════════════════════════════════════════════════════════════════════
+
+class LUFSMeter {
+private:
+    StereoZDFBiquad<double> preFilter;   // K-weighting stage 1 (L/R lane pair)
+    StereoZDFBiquad<double> rlbFilter;   // K-weighting stage 2
+    double sampleRate;
+    constexpr static double ABSOLUTE_GATE = -70.0;
+    constexpr static double RELATIVE_GATE_OFFSET = -10.0;
+
+    // Everything is built from 100ms sub-block energy sums:
+    // - Momentary window / BS.1770-4 gating blocks: 400ms at a 100ms hop
+    // - Short-term window / EBU Tech 3342 LRA blocks: 3s, LRA at a 1s hop
+    constexpr static int SUB_BLOCKS_PER_GATING_BLOCK = 4;
+    constexpr static int SUB_BLOCKS_PER_LRA_BLOCK = 30;
+    constexpr static int SUB_BLOCKS_PER_LRA_HOP = 10;
+    constexpr static double LRA_RELATIVE_GATE = -20.0;
+    // Running sums are rebuilt exactly every minute to bound drift
+    constexpr static int SUB_BLOCKS_PER_RESUM = 600;
+    int subBlockSize;
+    int subBlockSamples = 0;
+    double subBlockSum = 0.0;
+    std::array<double, SUB_BLOCKS_PER_LRA_BLOCK> recentSubBlocks{};
+    int64_t subBlocksSeen = 0;
+    LoudnessHistogram gatingHistogram;
+    LoudnessHistogram lraHistogram;
+
+    // Kahan-compensated sum of a sliding window of sub-blocks
+    struct RunningSum {
+        double sum = 0.0;
+        double compensation = 0.0;
+
+        void add(double value) {
+            double y = value - compensation;
+            double t = sum + y;
+            compensation = (t - sum) - y;
+            sum = t;
+        }
+
+        void reset(double value = 0.0) {
+            sum = value;
+            compensation = 0.0;
+        }
+    };
+    RunningSum momentarySum;
+    RunningSum shortTermSum;
+
+    // Sum of the most recent `count` sub-blocks
+    double sumRecentSubBlocks(int count) const {
+        double sum = 0.0;
+        for (int i = 1; i <= count; ++i) {
+            sum += recentSubBlocks[(subBlocksSeen - i) % SUB_BLOCKS_PER_LRA_BLOCK];
+        }
+        return sum;
+    }
+
+    void completeSubBlock() {
+        // Slide both windows: add the new sub-block, drop the ones leaving
+        int slot = static_cast<int>(subBlocksSeen % SUB_BLOCKS_PER_LRA_BLOCK);
+        double leavingShortTerm = recentSubBlocks[slot];
+        double leavingMomentary = (subBlocksSeen >= SUB_BLOCKS_PER_GATING_BLOCK)
+            ? recentSubBlocks[(subBlocksSeen - SUB_BLOCKS_PER_GATING_BLOCK) % SUB_BLOCKS_PER_LRA_BLOCK]
+            : 0.0;
+
+        recentSubBlocks[slot] = subBlockSum;
+        subBlocksSeen++;
+        momentarySum.add(subBlockSum - leavingMomentary);
+        shortTermSum.add(subBlockSum - leavingShortTerm);
+        subBlockSum = 0.0;
+        subBlockSamples = 0;
+
+        if (subBlocksSeen % SUB_BLOCKS_PER_RESUM == 0) {
+            momentarySum.reset(sumRecentSubBlocks(SUB_BLOCKS_PER_GATING_BLOCK));
+            shortTermSum.reset(sumRecentSubBlocks(SUB_BLOCKS_PER_LRA_BLOCK));
+        }
+
+        if (subBlocksSeen >= SUB_BLOCKS_PER_GATING_BLOCK) {
+            gatingHistogram.addBlock(windowMeanSquare(momentarySum, SUB_BLOCKS_PER_GATING_BLOCK));
+        }
+
+        if (subBlocksSeen >= SUB_BLOCKS_PER_LRA_BLOCK &&
+            (subBlocksSeen - SUB_BLOCKS_PER_LRA_BLOCK) % SUB_BLOCKS_PER_LRA_HOP == 0) {
+            lraHistogram.addBlock(windowMeanSquare(shortTermSum, SUB_BLOCKS_PER_LRA_BLOCK));
+        }
+    }
+
+    // Cancellation can leave a tiny negative residue after loud passages
+    double windowMeanSquare(const RunningSum& window, int subBlocks) const {
+        return std::max(0.0, window.sum) / (subBlocks * subBlockSize);
+    }
+
+public:
+    LUFSMeter(double sr = 48000.0) {
+        setSampleRate(sr);
+    }
+
+    // K-weighting and the 100ms sub-block follow the rate; the measurement
+    // so far is kept
+    void setSampleRate(double sr) {
+        sampleRate = sr;
+        preFilter.setSampleRate(sr);
+        rlbFilter.setSampleRate(sr);
+        preFilter.setCoefficients(100.0, 0.707, 0.0, ZDFDesign::HIGHPASS);
+        rlbFilter.setCoefficients(1000.0, 0.707, 4.0, ZDFDesign::HIGHSHELF);
+
+        subBlockSize = std::max(1, static_cast<int>(std::lround(0.1 * sampleRate)));
+    }
+
+    void processSample(double left, double right) {
+        Double2 filtered = rlbFilter.process(preFilter.process(Double2(left, right)));
+        double filteredL = filtered.left();
+        double filteredR = filtered.right();
+
+        double meanSquare = (filteredL * filteredL + filteredR * filteredR) / 2.0;
+
+        subBlockSum += meanSquare;
+        if (++subBlockSamples >= subBlockSize) {
+            completeSubBlock();
+        }
+    }
+
+    template <typename Sample>
+    void processBlock(const Sample* left, const Sample* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            processSample(left[i], right[i]);
+        }
+    }
+
+    // Gated integrated loudness from the block histogram: O(1) in programme length
+    double getIntegratedLUFS() {
+        return gatingHistogram.gatedLoudness(RELATIVE_GATE_OFFSET);
+    }
+
+    // Sliding-window loudness from the running sub-block sums: O(1) per query,
+    // updated every 100ms (EBU R128 asks for at least 10 Hz)
+    double getShortTermLUFS() {
+        double meanPower = windowMeanSquare(shortTermSum, SUB_BLOCKS_PER_LRA_BLOCK);
+        return -0.691 + 10.0 * std::log10(std::max(meanPower, 1e-10));
+    }
+
+    double getMomentaryLUFS() {
+        double meanPower = windowMeanSquare(momentarySum, SUB_BLOCKS_PER_GATING_BLOCK);
+        return -0.691 + 10.0 * std::log10(std::max(meanPower, 1e-10));
+    }
+
+    // LRA (Loudness Range) - Measures macro-dynamics (verse-to-chorus variation)
+    // EBU Tech 3342: 3s short-term blocks at a 1s hop, absolute gate -70 LUFS,
+    // relative gate -20 LU, then the 10th-95th percentile spread in LU.
+    // Read from a streaming histogram, so it is valid live at any point.
+    double getLRA() {
+        if (lraHistogram.getBlockCount() < 2) return 0.0;
+
+        double low = lraHistogram.percentile(0.10, LRA_RELATIVE_GATE);
+        double high = lraHistogram.percentile(0.95, LRA_RELATIVE_GATE);
+        return std::max(0.0, high - low); // Ensure non-negative
+    }
+
+    void reset() {
+        gatingHistogram.reset();
+        lraHistogram.reset();
+        recentSubBlocks.fill(0.0);
+        subBlocksSeen = 0;
+        subBlockSum = 0.0;
+        subBlockSamples = 0;
+        momentarySum.reset();
+        shortTermSum.reset();
+        preFilter.reset();
+        rlbFilter.reset();
+    }
+};
@@ -0,0 +1,119 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Loudness Histogram (ITU-R BS.1770-4 / EBU R128 gating)
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Fixed-resolution histogram of gating-block loudness. Each bin keeps the
+ * block count AND the exact sum of block mean-square energies, so gated
+ * means are exact except for blocks sharing a bin with the relative gate.
+ *
+ * - Constant memory regardless of programme length (800 bins, ~10 KB)
+ * - Constant-time integrated loudness and percentile queries
+ * - No allocation after construction (safe on the audio thread)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+class LoudnessHistogram {
+public:
+    constexpr static double ABSOLUTE_GATE = -70.0;  // LUFS
+    constexpr static double MAX_LUFS = 10.0;
+    constexpr static double BIN_WIDTH = 0.1;        // LU
+    constexpr static int BIN_COUNT = 800;           // (MAX_LUFS - ABSOLUTE_GATE) / BIN_WIDTH
+
+    static double energyToLUFS(double meanSquare) {
+        return -0.691 + 10.0 * std::log10(std::max(meanSquare, 1e-20));
+    }
+
+    static double lufsToEnergy(double lufs) {
+        return std::pow(10.0, (lufs + 0.691) / 10.0);
+    }
+
+    // Add one gating block. Blocks at or below the absolute gate are discarded.
+    void addBlock(double meanSquare) {
+        double lufs = energyToLUFS(meanSquare);
+        if (lufs <= ABSOLUTE_GATE) return;
+
+        int bin = binIndex(lufs);
+        counts[bin]++;
+        energies[bin] += meanSquare;
+        totalCount++;
+        totalEnergy += meanSquare;
+    }
+
+    uint64_t getBlockCount() const { return totalCount; }
+
+    // Mean loudness of all blocks above (absolute gate AND mean + relativeGateLU).
+    // Returns ABSOLUTE_GATE when nothing passes the gates.
+    double gatedLoudness(double relativeGateLU) const {
+        if (totalCount == 0) return ABSOLUTE_GATE;
+
+        int firstBin = relativeGateBin(relativeGateLU);
+        uint64_t count = 0;
+        double energy = 0.0;
+        for (int i = firstBin; i < BIN_COUNT; ++i) {
+            count += counts[i];
+            energy += energies[i];
+        }
+
+        if (count == 0) return ABSOLUTE_GATE;
+        return energyToLUFS(energy / static_cast<double>(count));
+    }
+
+    // Loudness at `fraction` (0..1) of the distribution of blocks above the
+    // relative gate, resolved to the bin centre.
+    double percentile(double fraction, double relativeGateLU) const {
+        if (totalCount == 0) return ABSOLUTE_GATE;
+
+        int firstBin = relativeGateBin(relativeGateLU);
+        uint64_t count = 0;
+        for (int i = firstBin; i < BIN_COUNT; ++i) {
+            count += counts[i];
+        }
+        if (count == 0) return ABSOLUTE_GATE;
+
+        uint64_t target = static_cast<uint64_t>(fraction * static_cast<double>(count - 1));
+        uint64_t seen = 0;
+        for (int i = firstBin; i < BIN_COUNT; ++i) {
+            seen += counts[i];
+            if (seen > target) return binCentre(i);
+        }
+        return binCentre(BIN_COUNT - 1);
+    }
+
+    void reset() {
+        counts.fill(0);
+        energies.fill(0.0);
+        totalCount = 0;
+        totalEnergy = 0.0;
+    }
+
+private:
+    std::array<uint32_t, BIN_COUNT> counts{};
+    std::array<double, BIN_COUNT> energies{};
+    uint64_t totalCount = 0;
+    double totalEnergy = 0.0;
+
+    static int binIndex(double lufs) {
+        int bin = static_cast<int>((lufs - ABSOLUTE_GATE) / BIN_WIDTH);
+        return std::max(0, std::min(BIN_COUNT - 1, bin));
+    }
+
+    static double binCentre(int bin) {
+        return ABSOLUTE_GATE + (bin + 0.5) * BIN_WIDTH;
+    }
+
+    // First bin counted as above the relative gate: the bin whose centre
+    // lies above the gate (ungated mean of the absolute-gated blocks + offset)
+    int relativeGateBin(double relativeGateLU) const {
+        double gate = energyToLUFS(totalEnergy / static_cast<double>(totalCount)) + relativeGateLU;
+        if (gate <= ABSOLUTE_GATE) return 0;
+        int bin = binIndex(gate);
+        return (binCentre(bin) > gate) ? bin : bin + 1;
+    }
+};
@@ -0,0 +1,347 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Mastering Engine Core
+ * ═══════════════════════════════════════════════════════════════════════════
+ */
+
+#include "MasteringEngine.h"
+
+#include <algorithm>
+#include <cmath>
+
+template <typename Sample, typename Quality>
+MasteringEngineT<Sample, Quality>::MasteringEngineT(double sr)
+    : sampleRate(sr), limiter(sr), lufsMeter(sr), crestAnalyzer(4800) {
+    eq.setSampleRate(sr);
+    hfProtect.setSampleRate(sr);
+    deEsserL.setSampleRate(sr);
+    deEsserR.setSampleRate(sr);
+    multibandComp.setSampleRate(sr);
+    stereoImager.setSampleRate(sr);
+    saturationL.setSampleRate(sr);
+    saturationR.setSampleRate(sr);
+    inputGain.setSmoothTime(20.0, sr);
+    inputGain.setImmediate(0.0);
+    resetStream(128);
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::setSampleRate(double sr) {
+    sampleRate = sr;
+    eq.setSampleRate(sr);
+    hfProtect.setSampleRate(sr);
+    deEsserL.setSampleRate(sr);
+    deEsserR.setSampleRate(sr);
+    multibandComp.setSampleRate(sr);
+    stereoImager.setSampleRate(sr);
+    saturationL.setSampleRate(sr);
+    saturationR.setSampleRate(sr);
+    limiter.setSampleRate(sr);
+    lufsMeter.setSampleRate(sr);
+    inputGain.setSmoothTime(20.0, sr);
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::applyCommand(const ParameterCommand& command) {
+    const double value = command.value;
+    const bool flag = value != 0.0;
+
+    switch (command.id) {
+        case PARAM_INPUT_GAIN:              setInputGain(value); break;
+        case PARAM_DC_FILTER_ENABLED:       setDCOffsetFilterEnabled(flag); break;
+        case PARAM_EQ_GAIN:                 setEQGain(command.index, value); break;
+        case PARAM_DEESSER_ENABLED:         setDeEsserEnabled(flag); break;
+        case PARAM_DEESSER_THRESHOLD:       setDeEsserThreshold(value); break;
+        case PARAM_DEESSER_RATIO:           setDeEsserRatio(value); break;
+        case PARAM_MULTIBAND_ENABLED:       setMultibandEnabled(flag); break;
+        case PARAM_MULTIBAND_THRESHOLD:     multibandComp.setBandThreshold(command.index, value); break;
+        case PARAM_MULTIBAND_RATIO:         multibandComp.setBandRatio(command.index, value); break;
+        case PARAM_STEREO_WIDTH:            setStereoWidth(value); break;
+        case PARAM_SATURATION_DRIVE:        setSaturationDrive(value); break;
+        case PARAM_SATURATION_MIX:          setSaturationMix(value); break;
+        case PARAM_LIMITER_THRESHOLD:       setLimiterThreshold(value); break;
+        case PARAM_LIMITER_RELEASE:         setLimiterRelease(value); break;
+        case PARAM_LIMITER_SAFE_CLIP:       setLimiterSafeClipMode(flag); break;
+        case PARAM_DITHERING_ENABLED:       setDitheringEnabled(flag); break;
+        case PARAM_DITHERING_BITS:          setDitheringBits(static_cast<int>(value)); break;
+        case PARAM_AI_ENABLED:              setAIEnabled(flag); break;
+        case PARAM_MULTIBAND_KNEE:          multibandComp.setBandKnee(command.index, value); break;
+        case PARAM_MULTIBAND_STEREO_LINK:   setMultibandStereoLink(flag); break;
+        case PARAM_DITHERING_NOISE_SHAPING: setDitheringNoiseShaping(static_cast<int>(value)); break;
+        default: break;  // Unknown IDs are ignored
+    }
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::processStereo(Sample& left, Sample& right) {
+    RealtimeScope realtime("MasteringEngine::processStereo");
+
+    // ═══ 0. DC OFFSET REMOVAL ═══
+    left = dcFilterL.process(left);
+    right = dcFilterR.process(right);
+
+    // ═══ 1. INPUT GAIN / TRIM ═══
+    Sample gainLinear = static_cast<Sample>(dbToLinear(inputGain.getSmoothed()));
+    left *= gainLinear;
+    right *= gainLinear;
+
+    // ═══ 2. ZDF EQ (with Nyquist De-cramping) ═══
+    eq.processStereo(left, right);
+
+    // ═══ 2b. HIGH-FREQUENCY AIR PROTECTION (prevents harsh square waves) ═══
+    hfProtect.processStereo(left, right);
+
+    // ═══ 3. INTELLIGENT DE-ESSER ═══
+    left = deEsserL.process(left);
+    right = deEsserR.process(right);
+
+    // ═══ 4. STEREO IMAGER / MONO-BASS (widen BEFORE compression) ═══
+    stereoImager.processStereo(left, right);
+
+    // ═══ 5. MULTIBAND COMPRESSOR (glues the widened signal) ═══
+    multibandComp.processStereo(left, right);
+
+    // ═══ 6. ANALOG SATURATION / SOFT-CLIPPER ═══
+    left = saturationL.process(left);
+    right = saturationR.process(right);
+
+    // ═══ 7. TRUE-PEAK LIMITER (4x oversampling + Safe-Clip mode) ═══
+    limiter.processStereo(left, right);
+
+    // ═══ 8. DITHERING (TPDF for bit-depth reduction) ═══
+    left = ditheringL.process(left);
+    right = ditheringR.process(right);
+
+    // ═══ METERING ═══
+    lufsMeter.processSample(left, right);
+    crestAnalyzer.processSample(left, right);
+
+    double l = left, r = right;
+    sumLL += l * l;
+    sumRR += r * r;
+    sumLR += l * r;
+    correlationSamples++;
+
+    if (correlationSamples >= CORRELATION_WINDOW) {
+        double denominator = std::sqrt(sumLL * sumRR);
+        phaseCorrelation = (denominator > 1e-10) ? (sumLR / denominator) : 0.0;
+
+        // Update health report
+        healthAnalyzer.analyze(
+            crestAnalyzer.getPeak(),
+            phaseCorrelation,
+            lufsMeter.getIntegratedLUFS()
+        );
+
+        if (aiEnabled) {
+            applyAIAdjustments();
+        }
+
+        sumLL = sumRR = sumLR = 0.0;
+        correlationSamples = 0;
+    }
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::processWorkBlock(int numSamples) {
+    Sample* left = workL.data();
+    Sample* right = workR.data();
+
+    // ═══ 0. DC OFFSET REMOVAL ═══
+    dcFilterL.processBlock(left, numSamples);
+    dcFilterR.processBlock(right, numSamples);
+
+    // ═══ 1. INPUT GAIN / TRIM (one pow per block once settled) ═══
+    if (inputGain.isSettled()) {
+        Sample gainLinear = static_cast<Sample>(dbToLinear(inputGain.getSmoothed()));
+        for (int i = 0; i < numSamples; ++i) {
+            left[i] *= gainLinear;
+            right[i] *= gainLinear;
+        }
+    } else {
+        for (int i = 0; i < numSamples; ++i) {
+            Sample gainLinear = static_cast<Sample>(dbToLinear(inputGain.getSmoothed()));
+            left[i] *= gainLinear;
+            right[i] *= gainLinear;
+        }
+    }
+
+    // ═══ 2. ZDF EQ (with Nyquist De-cramping) ═══
+    eq.processBlock(left, right, numSamples);
+
+    // ═══ 2b. HIGH-FREQUENCY AIR PROTECTION ═══
+    hfProtect.processBlock(left, right, numSamples);
+
+    // ═══ 3. INTELLIGENT DE-ESSER ═══
+    deEsserL.processBlock(left, numSamples);
+    deEsserR.processBlock(right, numSamples);
+
+    // ═══ 4. STEREO IMAGER / MONO-BASS ═══
+    stereoImager.processBlock(left, right, numSamples);
+
+    // ═══ 5. MULTIBAND COMPRESSOR ═══
+    multibandComp.processBlock(left, right, numSamples);
+
+    // ═══ 6. ANALOG SATURATION / SOFT-CLIPPER ═══
+    saturationL.processBlock(left, numSamples);
+    saturationR.processBlock(right, numSamples);
+
+    // ═══ 7. TRUE-PEAK LIMITER ═══
+    limiter.processBlock(left, right, numSamples);
+
+    // ═══ 8. DITHERING ═══
+    ditheringL.processBlock(left, numSamples);
+    ditheringR.processBlock(right, numSamples);
+
+    // ═══ METERING ═══
+    lufsMeter.processBlock(left, right, numSamples);
+    crestAnalyzer.processBlock(left, right, numSamples);
+
+    for (int i = 0; i < numSamples; ++i) {
+        double l = left[i], r = right[i];
+        sumLL += l * l;
+        sumRR += r * r;
+        sumLR += l * r;
+    }
+    correlationSamples += numSamples;
+
+    if (correlationSamples >= CORRELATION_WINDOW) {
+        double denominator = std::sqrt(sumLL * sumRR);
+        phaseCorrelation = (denominator > 1e-10) ? (sumLR / denominator) : 0.0;
+
+        healthAnalyzer.analyze(
+            crestAnalyzer.getPeak(),
+            phaseCorrelation,
+            lufsMeter.getIntegratedLUFS()
+        );
+
+        if (aiEnabled) {
+            applyAIAdjustments();
+        }
+
+        sumLL = sumRR = sumLR = 0.0;
+        correlationSamples = 0;
+    }
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::processPlanar(float* leftBuffer, float* rightBuffer, int numSamples) {
+    RealtimeScope realtime("MasteringEngine::processPlanar");
+    applyPendingCommands();
+
+    int offset = 0;
+    while (offset < numSamples) {
+        // Split at the correlation window so the AI adjustment (which
+        // re-tunes the multiband compressor) takes effect on the next sample
+        int count = std::min({numSamples - offset, MAX_BLOCK_SIZE, CORRELATION_WINDOW - correlationSamples});
+
+        for (int i = 0; i < count; ++i) {
+            workL[i] = leftBuffer[offset + i];
+            workR[i] = rightBuffer[offset + i];
+        }
+
+        processWorkBlock(count);
+
+        for (int i = 0; i < count; ++i) {
+            leftBuffer[offset + i] = static_cast<float>(workL[i]);
+            rightBuffer[offset + i] = static_cast<float>(workR[i]);
+        }
+        offset += count;
+    }
+
+    advanceMeterClock(numSamples);
+}
+
+template <typename Sample, typename Quality>
+int MasteringEngineT<Sample, Quality>::processQueued() {
+    RealtimeScope realtime("MasteringEngine::processQueued");
+    const uint32_t blockSize = static_cast<uint32_t>(internalBlockSize);
+    int blocks = 0;
+
+    while (inputRing.availableRead() >= blockSize &&
+           outputRing.availableWrite() >= blockSize) {
+        inputRing.read(blockBufferL.data(), blockBufferR.data(), blockSize);
+        processPlanar(blockBufferL.data(), blockBufferR.data(), internalBlockSize);
+        outputRing.write(blockBufferL.data(), blockBufferR.data(), blockSize);
+        ++blocks;
+    }
+    return blocks;
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::resetStream(int quantumSize) {
+    quantumSize = std::max(1, std::min(quantumSize, internalBlockSize));
+    inputRing.reset();
+    outputRing.reset();
+    streamLatency = internalBlockSize - quantumSize;
+    outputRing.writeSilence(static_cast<uint32_t>(streamLatency));
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::applyAIAdjustments() {
+    double cf = crestAnalyzer.getCrestFactor();
+
+    if (cf > 15.0) {
+        multibandComp.setEnabled(true);
+        multibandComp.setLowBand(-24.0, 3.0);
+        multibandComp.setMidBand(-20.0, 3.5);
+        multibandComp.setHighBand(-18.0, 4.0);
+    } else if (cf > 12.0) {
+        multibandComp.setEnabled(true);
+        multibandComp.setLowBand(-20.0, 2.5);
+        multibandComp.setMidBand(-18.0, 3.0);
+        multibandComp.setHighBand(-16.0, 3.5);
+    } else if (cf > 8.0) {
+        multibandComp.setEnabled(true);
+        multibandComp.setLowBand(-18.0, 2.0);
+        multibandComp.setMidBand(-16.0, 2.0);
+        multibandComp.setHighBand(-14.0, 2.5);
+    } else {
+        multibandComp.setEnabled(false);
+    }
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::publishMeterSnapshot() {
+    RealtimeScope realtime("MasteringEngine::publishMeterSnapshot");
+    MeterSnapshot values;
+    values.momentaryLUFS = lufsMeter.getMomentaryLUFS();
+    values.shortTermLUFS = lufsMeter.getShortTermLUFS();
+    values.integratedLUFS = lufsMeter.getIntegratedLUFS();
+    values.loudnessRange = lufsMeter.getLRA();
+    values.truePeakDB = limiter.getTruePeak();
+    values.crestFactorDB = crestAnalyzer.getCrestFactor();
+    values.phaseCorrelation = phaseCorrelation;
+    values.deEsserGainReduction = deEsserL.getGainReduction();
+    values.limiterGainReduction = limiter.getGainReduction();
+    meterPublisher.publish(values);
+}
+
+template <typename Sample, typename Quality>
+void MasteringEngineT<Sample, Quality>::reset() {
+    dcFilterL.reset();
+    dcFilterR.reset();
+    eq.reset();
+    hfProtect.reset();
+    deEsserL.reset();
+    deEsserR.reset();
+    multibandComp.reset();
+    stereoImager.reset();
+    saturationL.reset();
+    saturationR.reset();
+    limiter.reset();
+    ditheringL.reset();
+    ditheringR.reset();
+    lufsMeter.reset();
+    crestAnalyzer.reset();
+    sumLL = sumRR = sumLR = 0.0;
+    correlationSamples = 0;
+    phaseCorrelation = 0.0;
+    meterCounter = 0;
+    publishMeterSnapshot();
+}
+
+template class MasteringEngineT<double>;
+template class MasteringEngineT<float>;
+template class MasteringEngineT<float, RealtimePreviewQuality>;
+template class MasteringEngineT<double, ExportQuality>;
@@ -0,0 +1,407 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Mastering Engine Core
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * The complete mastering chain with no Emscripten dependency. Built natively
+ * as libluvlang_dsp.a (see CMakeLists.txt) and wrapped for the browser by the
+ * embind adapter in MasteringEngine_100_PERCENT_ULTIMATE.cpp, so the server
+ * and the AudioWorklet render the exact same chain.
+ *
+ * The chain is templated on its working sample type and on the limiter's
+ * oversampling tier. MasteringEngine (double, standard 4x) is the reference
+ * build. MasteringEngineF32 runs every filter, envelope and the oversampler
+ * in float while parameter smoothing, loudness and correlation accumulators
+ * stay in double. MasteringEnginePreview (float, 2x) is the cheap browser
+ * preview and MasteringEngineExport (double, 8x) the server render. All four
+ * are instantiated in MasteringEngine.cpp.
+ */
+
+#pragma once
+
+#include "AnalogSaturation.h"
+#include "Analyzers.h"
+#include "AudioRingBuffer.h"
+#include "Crossover.h"
+#include "DSPCommon.h"
+#include "Dithering.h"
+#include "Dynamics.h"
+#include "Equalizer.h"
+#include "LUFSMeter.h"
+#include "MeterSnapshot.h"
+#include "ParameterCommandQueue.h"
+#include "RealtimeAudit.h"
+#include "StereoImager.h"
+#include "TruePeakLimiter.h"
+
+#include <array>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// 100% ULTIMATE LEGENDARY MASTERING ENGINE
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample, typename Quality = StandardQuality>
+class MasteringEngineT {
+private:
+    double sampleRate;
+
+    // ═══ SIGNAL CHAIN (COMPLETE, IN PERFECT ORDER) ═══
+    DCOffsetFilter<Sample> dcFilterL, dcFilterR;  // 0. DC Offset Removal
+    ParameterSmoother inputGain;                  // 1. Input Gain / Trim
+    SevenBandEQ<Sample> eq;                       // 2. ZDF EQ (stereo SIMD)
+    HighFrequencyProtection<Sample> hfProtect;    // 2b. Air Band Protection (NEW!)
+    DeEsser<Sample> deEsserL, deEsserR;           // 3. De-Esser
+    MultibandCompressor<Sample> multibandComp;    // 4. Multiband Compressor
+    StereoImager<Sample> stereoImager;            // 5. Stereo Imager
+    AnalogSaturation<Sample> saturationL, saturationR;  // 6. Saturation
+    TruePeakLimiter<Sample, Quality> limiter;     // 7. True-Peak Limiter (with Safe-Clip)
+    Dithering<Sample> ditheringL{0}, ditheringR{1};  // 8. Dithering (independent streams)
+
+    // Metering & Analysis
+    LUFSMeter lufsMeter;
+    CrestFactorAnalyzer crestAnalyzer;
+    MixHealthAnalyzer healthAnalyzer;
+    double phaseCorrelation = 0.0;
+
+    // Phase correlation calculation
+    double sumLL = 0.0;
+    double sumRR = 0.0;
+    double sumLR = 0.0;
+    int correlationSamples = 0;
+    constexpr static int CORRELATION_WINDOW = 4800;
+
+    // Engine-owned planar block buffers for processBlock() (WASM heap)
+    constexpr static int MAX_BLOCK_SIZE = 4096;
+    std::array<float, MAX_BLOCK_SIZE> blockBufferL{};
+    std::array<float, MAX_BLOCK_SIZE> blockBufferR{};
+
+    // Work buffers the chain runs over stage by stage
+    std::array<Sample, MAX_BLOCK_SIZE> workL{};
+    std::array<Sample, MAX_BLOCK_SIZE> workR{};
+
+    // Streaming: worklet quanta in, larger internal blocks through the chain
+    AudioRingBuffer inputRing;
+    AudioRingBuffer outputRing;
+    int internalBlockSize = 512;
+    int streamLatency = 0;
+
+    // Parameter changes, applied at block boundaries
+    ParameterCommandQueue commandQueue;
+
+    // Metering published at control rate
+    MeterSnapshotPublisher meterPublisher;
+    int meterCounter = 0;
+    constexpr static int METER_PUBLISH_INTERVAL = 2048;  // ~43ms @ 48kHz
+
+    bool aiEnabled = false;
+
+    // Run every stage over workL/workR[0, numSamples); the span never
+    // crosses a correlation window, so AI re-tuning lands on the same
+    // sample as in processStereo()
+    void processWorkBlock(int numSamples);
+
+public:
+    using SampleType = Sample;
+
+    MasteringEngineT(double sr = 48000.0);
+
+    void setSampleRate(double sr);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // CONTROL METHODS
+    // ═══════════════════════════════════════════════════════════════════════
+
+    // DC Offset Filter
+    void setDCOffsetFilterEnabled(bool enabled) {
+        dcFilterL.setEnabled(enabled);
+        dcFilterR.setEnabled(enabled);
+    }
+
+    // Input Gain
+    void setInputGain(double gainDB) {
+        inputGain.setTarget(gainDB);
+    }
+
+    // Jump straight to gainDB without the 20ms ramp (offline renders)
+    void setInputGainImmediate(double gainDB) {
+        inputGain.setImmediate(gainDB);
+    }
+
+    // EQ
+    void setEQGain(int band, double gainDB) {
+        eq.setBandGain(band, gainDB);
+    }
+
+    void setAllEQGains(const std::array<double, 7>& gains) {
+        eq.setAllGains(gains);
+    }
+
+    // De-Esser (NEW!)
+    void setDeEsserEnabled(bool enabled) {
+        deEsserL.setEnabled(enabled);
+        deEsserR.setEnabled(enabled);
+    }
+
+    void setDeEsserThreshold(double thresholdDB) {
+        deEsserL.setThreshold(thresholdDB);
+        deEsserR.setThreshold(thresholdDB);
+    }
+
+    void setDeEsserRatio(double ratio) {
+        deEsserL.setRatio(ratio);
+        deEsserR.setRatio(ratio);
+    }
+
+    // Multiband Compressor
+    void setMultibandEnabled(bool enabled) {
+        multibandComp.setEnabled(enabled);
+    }
+
+    void setMultibandLowBand(double threshold, double ratio) {
+        multibandComp.setLowBand(threshold, ratio);
+    }
+
+    void setMultibandMidBand(double threshold, double ratio) {
+        multibandComp.setMidBand(threshold, ratio);
+    }
+
+    void setMultibandHighBand(double threshold, double ratio) {
+        multibandComp.setHighBand(threshold, ratio);
+    }
+
+    // Soft-knee width (dB) for all three bands
+    void setMultibandKnee(double kneeDB) {
+        for (int band = 0; band < 3; ++band) {
+            multibandComp.setBandKnee(band, kneeDB);
+        }
+    }
+
+    // Linked (default): one detector per band for both channels
+    void setMultibandStereoLink(bool linked) {
+        multibandComp.setStereoLink(linked);
+    }
+
+    // Stereo Imager
+    void setStereoWidth(double width) {
+        stereoImager.setWidth(width);
+    }
+
+    // Saturation
+    void setSaturationDrive(double drive) {
+        saturationL.setDrive(drive);
+        saturationR.setDrive(drive);
+    }
+
+    void setSaturationMix(double mix) {
+        saturationL.setMix(mix);
+        saturationR.setMix(mix);
+    }
+
+    // Limiter (with Safe-Clip mode - NEW!)
+    void setLimiterThreshold(double thresholdDB) {
+        limiter.setThreshold(thresholdDB);
+    }
+
+    void setLimiterRelease(double releaseSec) {
+        limiter.setRelease(releaseSec);
+    }
+
+    void setLimiterSafeClipMode(bool enabled) {
+        limiter.setSafeClipMode(enabled);
+    }
+
+    // Half-band IIR instead of the linear-phase FIR for true-peak
+    // oversampling: a few samples of latency instead of TAP_COUNT / FACTOR,
+    // for live monitoring. Changes getLatencySamples(), so set it from the
+    // main thread, not through the parameter queue
+    void setLowLatencyOversampling(bool enabled) {
+        limiter.setOversamplingFilter(enabled ? OVERSAMPLING_HALF_BAND_IIR : OVERSAMPLING_LINEAR_PHASE_FIR);
+    }
+
+    // Limiter look-ahead / attack time in ms (0 .. MAX_LOOKAHEAD_MS, default
+    // 50). Restarts the limiter's delay line and changes getLatencySamples(),
+    // so set it from the main thread as well. Never allocates.
+    void setLimiterLookAhead(double ms) {
+        limiter.setLookAhead(ms);
+    }
+
+    double getLimiterLookAhead() { return limiter.getLookAhead(); }
+
+    // Dithering
+    void setDitheringEnabled(bool enabled) {
+        ditheringL.setEnabled(enabled);
+        ditheringR.setEnabled(enabled);
+    }
+
+    void setDitheringBits(int bits) {
+        ditheringL.setTargetBits(bits);
+        ditheringR.setTargetBits(bits);
+    }
+
+    // 0 = flat TPDF, 1 = F-weighted 9-tap, 2 = first-order high-pass
+    void setDitheringNoiseShaping(int mode) {
+        ditheringL.setNoiseShaping(static_cast<NoiseShaping>(mode));
+        ditheringR.setNoiseShaping(static_cast<NoiseShaping>(mode));
+    }
+
+    // AI
+    void setAIEnabled(bool enabled) {
+        aiEnabled = enabled;
+    }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // PARAMETER COMMAND QUEUE
+    // ═══════════════════════════════════════════════════════════════════════
+
+    bool pushParameter(int id, int index, double value) {
+        ParameterCommand command{static_cast<uint32_t>(id), index, value};
+        return commandQueue.push(command);
+    }
+
+    uintptr_t getCommandQueuePtr() { return reinterpret_cast<uintptr_t>(&commandQueue); }
+
+    void applyPendingCommands() {
+        RealtimeScope realtime("MasteringEngine::applyPendingCommands");
+        ParameterCommand command;
+        while (commandQueue.pop(command)) {
+            applyCommand(command);
+        }
+    }
+
+    void applyCommand(const ParameterCommand& command);
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // ✨ 100% ULTIMATE LEGENDARY SIGNAL FLOW ✨
+    // ═══════════════════════════════════════════════════════════════════════
+
+    // Single frame through the whole chain (reference path; processPlanar()
+    // runs the same chain stage by stage and matches it bit for bit)
+    void processStereo(Sample& left, Sample& right);
+
+    // Zero-copy block processing (planar float32, in place).
+    // The worklet copies each channel into the engine-owned heap buffers
+    // once with HEAPF32.set() and makes a single call per render quantum,
+    // instead of four val round-trips per stereo frame in processBuffer().
+    void processBlock(uintptr_t leftPtr, uintptr_t rightPtr, int numSamples) {
+        processPlanar(reinterpret_cast<float*>(leftPtr),
+                      reinterpret_cast<float*>(rightPtr), numSamples);
+    }
+
+    void processPlanar(float* leftBuffer, float* rightBuffer, int numSamples);
+
+    uintptr_t getLeftBufferPtr() { return reinterpret_cast<uintptr_t>(blockBufferL.data()); }
+    uintptr_t getRightBufferPtr() { return reinterpret_cast<uintptr_t>(blockBufferR.data()); }
+    int getMaxBlockSize() { return MAX_BLOCK_SIZE; }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // STREAMING (SPSC ring buffers shared with the AudioWorklet)
+    // ═══════════════════════════════════════════════════════════════════════
+
+    // Drain every complete internal block waiting in the input ring through
+    // the chain and into the output ring. Returns the number of blocks run.
+    int processQueued();
+
+    // Clear both rings and pre-fill the output with just enough silence that
+    // a reader pulling quantumSize frames per callback never underruns while
+    // the input ring accumulates a full internal block. Call only while the
+    // stream is stopped.
+    void resetStream(int quantumSize);
+
+    void setInternalBlockSize(int blockSize, int quantumSize) {
+        internalBlockSize = std::max(quantumSize, std::min(blockSize, MAX_BLOCK_SIZE));
+        resetStream(quantumSize);
+    }
+
+    int getInternalBlockSize() { return internalBlockSize; }
+    int getStreamLatencySamples() { return streamLatency; }
+    uintptr_t getInputRingPtr() { return reinterpret_cast<uintptr_t>(&inputRing); }
+    uintptr_t getOutputRingPtr() { return reinterpret_cast<uintptr_t>(&outputRing); }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // AI AUTO-MASTERING
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void applyAIAdjustments();
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // METERING & UTILITIES
+    // ═══════════════════════════════════════════════════════════════════════
+
+    // The loudness getters walk the gating histograms; they run in realtime
+    // scopes because the worklet may poll them between quanta
+    double getIntegratedLUFS() {
+        RealtimeScope realtime("MasteringEngine::getIntegratedLUFS");
+        return lufsMeter.getIntegratedLUFS();
+    }
+
+    double getShortTermLUFS() {
+        RealtimeScope realtime("MasteringEngine::getShortTermLUFS");
+        return lufsMeter.getShortTermLUFS();
+    }
+
+    double getMomentaryLUFS() {
+        RealtimeScope realtime("MasteringEngine::getMomentaryLUFS");
+        return lufsMeter.getMomentaryLUFS();
+    }
+
+    double getLRA() {
+        RealtimeScope realtime("MasteringEngine::getLRA");
+        return lufsMeter.getLRA();
+    }
+
+    double getPhaseCorrelation() { return phaseCorrelation; }
+    double getCrestFactor() { return crestAnalyzer.getCrestFactor(); }
+    double getLimiterGainReduction() { return limiter.getGainReduction(); }
+    double getPeakDB() { return crestAnalyzer.getPeak(); }
+    double getRMSDB() { return crestAnalyzer.getRMS(); }
+    double getDeEsserGainReduction() { return deEsserL.getGainReduction(); }
+
+    double getTruePeakDB() { return limiter.getTruePeak(); }
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // METER SNAPSHOT
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void advanceMeterClock(int numSamples) {
+        meterCounter += numSamples;
+        if (meterCounter >= METER_PUBLISH_INTERVAL) {
+            publishMeterSnapshot();
+            meterCounter = 0;
+        }
+    }
+
+    void publishMeterSnapshot();
+
+    bool readMeterSnapshot(MeterSnapshot& values) const {
+        return meterPublisher.read(values);
+    }
+
+    uintptr_t getMeterSnapshotPtr() { return reinterpret_cast<uintptr_t>(&meterPublisher); }
+
+    // Latency Compensation: processBuffer/processBlock output lags the input
+    // by exactly this many samples at the current rate. The limiter (look-ahead
+    // + oversampler round trip) is the only stage with a bulk delay; the EQ,
+    // crossovers and filters are minimum-phase IIR. The AudioWorklet ring
+    // adds getStreamLatencySamples() on top.
+    int getLatencySamples() {
+        return limiter.getLatencySamples();
+    }
+
+    // Mix Health Report (NEW!)
+    MixHealthReport getMixHealthReport() const {
+        return healthAnalyzer.getReport();
+    }
+
+    void reset();
+};
+
+using MasteringEngine = MasteringEngineT<double>;
+using MasteringEngineF32 = MasteringEngineT<float>;
+using MasteringEnginePreview = MasteringEngineT<float, RealtimePreviewQuality>;
+using MasteringEngineExport = MasteringEngineT<double, ExportQuality>;
+
+extern template class MasteringEngineT<double>;
+extern template class MasteringEngineT<float>;
+extern template class MasteringEngineT<float, RealtimePreviewQuality>;
+extern template class MasteringEngineT<double, ExportQuality>;
@@ -0,0 +1,66 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Meter Snapshot Publisher
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Seqlock-protected metering snapshot read without function calls.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// METER SNAPSHOT (seqlock-protected, read by JS without function calls)
+// ═══════════════════════════════════════════════════════════════════════════
+// The engine publishes one packed snapshot at control rate. Readers copy the
+// fields between two loads of `sequence` and retry if it was odd (write in
+// progress) or changed (torn read).
+//
+// Memory layout (read directly by MasteringProcessor.js):
+//   [0] sequence  [1] fieldCount   (uint32)
+//   float64 fields[fieldCount]     (MeterSnapshot order)
+
+struct MeterSnapshot {
+    double momentaryLUFS = -70.0;
+    double shortTermLUFS = -70.0;
+    double integratedLUFS = -70.0;
+    double loudnessRange = 0.0;        // LU
+    double truePeakDB = -100.0;        // dBTP (max since reset)
+    double crestFactorDB = 0.0;
+    double phaseCorrelation = 0.0;
+    double deEsserGainReduction = 0.0;  // dB
+    double limiterGainReduction = 0.0;  // dB
+};
+
+class MeterSnapshotPublisher {
+private:
+    std::atomic<uint32_t> sequence{0};
+    uint32_t fieldCount = sizeof(MeterSnapshot) / sizeof(double);
+    MeterSnapshot snapshot;
+
+public:
+    // Writer (audio thread)
+    void publish(const MeterSnapshot& values) {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        snapshot = values;
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader (any thread): false if a consistent copy could not be taken
+    bool read(MeterSnapshot& values, int maxAttempts = 4) const {
+        for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+            uint32_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1u) continue;
+            values = snapshot;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) return true;
+        }
+        return false;
+    }
+};
+
+static_assert(sizeof(MeterSnapshot) == 9 * sizeof(double), "MeterSnapshot must stay packed");
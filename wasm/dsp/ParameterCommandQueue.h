@@ -0,0 +1,98 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Lock-Free Parameter Command Queue
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Parameter changes queued by the control side, applied at block boundaries.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LOCK-FREE PARAMETER COMMAND QUEUE
+// ═══════════════════════════════════════════════════════════════════════════
+// Fixed-capacity SPSC queue of POD commands. The control side (worklet
+// message handler, or the UI thread directly when memory is shared) pushes;
+// the engine drains once per block before processing, so every parameter
+// change lands on a block boundary and costs nothing per call on the audio
+// thread.
+//
+// Memory layout (written directly by MasteringProcessor.js):
+//   [0] writeIndex  [1] readIndex  [2] capacity  [3] reserved   (uint32)
+//   ParameterCommand commands[CAPACITY]   (16 bytes each)
+
+// Keep in sync with ParamID in MasteringProcessor.js
+enum ParamID : uint32_t {
+    PARAM_INPUT_GAIN = 0,
+    PARAM_DC_FILTER_ENABLED,
+    PARAM_EQ_GAIN,                 // index = band (0-6)
+    PARAM_DEESSER_ENABLED,
+    PARAM_DEESSER_THRESHOLD,
+    PARAM_DEESSER_RATIO,
+    PARAM_MULTIBAND_ENABLED,
+    PARAM_MULTIBAND_THRESHOLD,     // index = band (0 low, 1 mid, 2 high)
+    PARAM_MULTIBAND_RATIO,         // index = band (0 low, 1 mid, 2 high)
+    PARAM_STEREO_WIDTH,
+    PARAM_SATURATION_DRIVE,
+    PARAM_SATURATION_MIX,
+    PARAM_LIMITER_THRESHOLD,
+    PARAM_LIMITER_RELEASE,
+    PARAM_LIMITER_SAFE_CLIP,
+    PARAM_DITHERING_ENABLED,
+    PARAM_DITHERING_BITS,
+    PARAM_AI_ENABLED,
+    PARAM_MULTIBAND_KNEE,          // index = band (0 low, 1 mid, 2 high)
+    PARAM_MULTIBAND_STEREO_LINK,
+    PARAM_DITHERING_NOISE_SHAPING, // 0 flat, 1 F-weighted, 2 high-pass
+    PARAM_COUNT
+};
+
+struct ParameterCommand {
+    uint32_t id;
+    int32_t index;
+    double value;
+};
+
+static_assert(sizeof(ParameterCommand) == 16, "JS writes commands as 16-byte records");
+
+class ParameterCommandQueue {
+public:
+    constexpr static uint32_t CAPACITY = 1024;
+    constexpr static uint32_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "capacity must be a power of two");
+
+private:
+    std::atomic<uint32_t> writeIndex{0};
+    std::atomic<uint32_t> readIndex{0};
+    uint32_t capacity = CAPACITY;
+    uint32_t reserved = 0;
+    std::array<ParameterCommand, CAPACITY> commands{};
+
+public:
+    // Producer side: false if the queue is full (command dropped)
+    bool push(const ParameterCommand& command) {
+        uint32_t w = writeIndex.load(std::memory_order_relaxed);
+        if (w - readIndex.load(std::memory_order_acquire) >= CAPACITY) return false;
+        commands[w & MASK] = command;
+        writeIndex.store(w + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side
+    bool pop(ParameterCommand& command) {
+        uint32_t r = readIndex.load(std::memory_order_relaxed);
+        if (r == writeIndex.load(std::memory_order_acquire)) return false;
+        command = commands[r & MASK];
+        readIndex.store(r + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t size() const {
+        return writeIndex.load(std::memory_order_acquire) -
+               readIndex.load(std::memory_order_acquire);
+    }
+};
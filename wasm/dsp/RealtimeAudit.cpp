@@ -0,0 +1,298 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Realtime-Safety Audit (allocation hooks)
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Compiled into audit builds only. Replaces the global operator new and
+ * delete families (portable) and, on glibc, interposes the malloc family,
+ * forwarding to glibc's own __libc_* entry points so operator new is not
+ * counted twice. The thread's scope label is a thread_local, so the check
+ * is one TLS load on every allocation.
+ */
+
+#include "RealtimeAudit.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#include <unistd.h>
+#define LUVLANG_AUDIT_BACKTRACE 1
+#endif
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+#endif
+
+namespace {
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+thread_local const char* activeLabel = nullptr;  // Innermost open scope, or none
+thread_local bool reporting = false;              // Inside trap(): let its own allocations through
+
+std::atomic<int> auditMode{REALTIME_AUDIT_COUNT};
+std::atomic<uint64_t> violationCount{0};
+std::atomic<int> nextRecord{0};
+RealtimeAuditRecord records[REALTIME_AUDIT_MAX_RECORDS];
+
+void printRecord(FILE* out, int index, const RealtimeAuditRecord& record) {
+    std::fprintf(out, "  #%d %s(%zu bytes) in realtime scope \"%s\"\n",
+                 index, record.function, record.bytes, record.scope);
+    std::fflush(out);
+#if defined(LUVLANG_AUDIT_BACKTRACE)
+    backtrace_symbols_fd(record.frames, record.frameCount, fileno(out));
+#else
+    for (int i = 0; i < record.frameCount; ++i) {
+        std::fprintf(out, "    %p\n", record.frames[i]);
+    }
+#endif
+}
+
+__attribute__((noinline)) void trap(const char* function, size_t bytes, void* caller) {
+    const char* label = activeLabel;
+    if (!label || reporting) return;
+    reporting = true;
+
+    RealtimeAuditRecord record;
+    record.scope = label;
+    record.function = function;
+    record.bytes = bytes;
+#if defined(LUVLANG_AUDIT_BACKTRACE)
+    // Frame 0 is trap() itself
+    void* frames[17];
+    int depth = backtrace(frames, 17);
+    record.frameCount = depth > 1 ? depth - 1 : 0;
+    std::memcpy(record.frames, frames + 1, record.frameCount * sizeof(void*));
+#else
+    record.frames[0] = caller;
+    record.frameCount = 1;
+#endif
+    (void)caller;
+
+    violationCount.fetch_add(1, std::memory_order_relaxed);
+    int slot = nextRecord.fetch_add(1, std::memory_order_relaxed);
+    if (slot < REALTIME_AUDIT_MAX_RECORDS) records[slot] = record;
+
+    if (auditMode.load(std::memory_order_relaxed) == REALTIME_AUDIT_ABORT) {
+        std::fprintf(stderr, "realtime audit: heap allocation on the audio thread\n");
+        printRecord(stderr, 0, record);
+        std::abort();
+    }
+    reporting = false;
+}
+
+// Environment override, backtrace warm-up (its first call loads the
+// unwinder, which allocates) and the exit report
+struct AuditSetup {
+    AuditSetup() {
+        if (const char* mode = std::getenv("LUVLANG_RT_AUDIT")) {
+            if (std::strcmp(mode, "abort") == 0) auditMode.store(REALTIME_AUDIT_ABORT);
+        }
+#if defined(LUVLANG_AUDIT_BACKTRACE)
+        void* frame;
+        backtrace(&frame, 1);
+#endif
+    }
+
+    ~AuditSetup() {
+        if (violationCount.load() > 0) printRealtimeAuditReport(stderr);
+    }
+} auditSetup;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RAW ALLOCATION (bypasses the malloc hooks below)
+// ═══════════════════════════════════════════════════════════════════════════
+
+void* rawAllocate(size_t size) {
+#if defined(__GLIBC__)
+    return __libc_malloc(size);
+#else
+    return std::malloc(size);
+#endif
+}
+
+void* rawAllocateAligned(size_t size, size_t alignment) {
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+#if defined(__GLIBC__)
+    return __libc_memalign(alignment, size);
+#else
+    void* pointer = nullptr;
+    return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+#endif
+}
+
+void* operatorNew(size_t size, size_t alignment, bool nothrow, void* caller) {
+    trap(alignment ? "aligned operator new" : "operator new", size, caller);
+    if (size == 0) size = 1;
+    for (;;) {
+        void* pointer = alignment ? rawAllocateAligned(size, alignment) : rawAllocate(size);
+        if (pointer) return pointer;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            if (nothrow) return nullptr;
+#if defined(__cpp_exceptions)
+            throw std::bad_alloc();
+#else
+            std::abort();
+#endif
+        }
+        handler();
+    }
+}
+
+}  // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PUBLIC API
+// ═══════════════════════════════════════════════════════════════════════════
+
+RealtimeScope::RealtimeScope(const char* label) : outerLabel(activeLabel) {
+    activeLabel = label;
+}
+
+RealtimeScope::~RealtimeScope() {
+    activeLabel = outerLabel;
+}
+
+void setRealtimeAuditMode(RealtimeAuditMode mode) {
+    auditMode.store(mode);
+}
+
+uint64_t realtimeAuditViolations() {
+    return violationCount.load();
+}
+
+int realtimeAuditRecordCount() {
+    int count = nextRecord.load();
+    return count < REALTIME_AUDIT_MAX_RECORDS ? count : REALTIME_AUDIT_MAX_RECORDS;
+}
+
+const RealtimeAuditRecord& realtimeAuditRecord(int index) {
+    return records[index];
+}
+
+void resetRealtimeAudit() {
+    violationCount.store(0);
+    nextRecord.store(0);
+}
+
+void printRealtimeAuditReport(FILE* out) {
+    uint64_t count = violationCount.load();
+    std::fprintf(out, "realtime audit: %llu heap allocation(s) inside realtime scopes\n",
+                 static_cast<unsigned long long>(count));
+    for (int i = 0; i < realtimeAuditRecordCount(); ++i) {
+        printRecord(out, i, records[i]);
+    }
+    if (count > REALTIME_AUDIT_MAX_RECORDS) {
+        std::fprintf(out, "  ... %llu more not recorded\n",
+                     static_cast<unsigned long long>(count - REALTIME_AUDIT_MAX_RECORDS));
+    }
+    std::fflush(out);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OPERATOR NEW / DELETE
+// ═══════════════════════════════════════════════════════════════════════════
+
+void* operator new(size_t size) {
+    return operatorNew(size, 0, false, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size) {
+    return operatorNew(size, 0, false, __builtin_return_address(0));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return operatorNew(size, 0, true, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return operatorNew(size, 0, true, __builtin_return_address(0));
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return operatorNew(size, static_cast<size_t>(alignment), false, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return operatorNew(size, static_cast<size_t>(alignment), false, __builtin_return_address(0));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return operatorNew(size, static_cast<size_t>(alignment), true, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return operatorNew(size, static_cast<size_t>(alignment), true, __builtin_return_address(0));
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MALLOC FAMILY (glibc interposition)
+// ═══════════════════════════════════════════════════════════════════════════
+// free() is left alone: glibc's frees all of these, and freeing is not
+// what this audit looks for.
+
+#if defined(__GLIBC__)
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+    trap("malloc", size, __builtin_return_address(0));
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    trap("calloc", count * size, __builtin_return_address(0));
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept {
+    trap("realloc", size, __builtin_return_address(0));
+    return __libc_realloc(pointer, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+    trap("memalign", size, __builtin_return_address(0));
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    trap("aligned_alloc", size, __builtin_return_address(0));
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** result, size_t alignment, size_t size) noexcept {
+    trap("posix_memalign", size, __builtin_return_address(0));
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) return EINVAL;
+    void* pointer = __libc_memalign(alignment, size);
+    if (!pointer) return ENOMEM;
+    *result = pointer;
+    return 0;
+}
+
+}  // extern "C"
+#endif
@@ -0,0 +1,103 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Realtime-Safety Audit
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Debug mode that traps heap allocation on the audio thread. The engine
+ * opens a RealtimeScope around everything the AudioWorklet calls
+ * (processBuffer/processBlock/processQueued, the parameter queue, the
+ * meter snapshot and the loudness getters). In an audit build
+ * (-DLUVLANG_RT_AUDIT=ON, see CMakeLists.txt) RealtimeAudit.cpp replaces
+ * operator new/new[] and, on glibc, malloc/calloc/realloc/memalign, and
+ * any call made while the calling thread is inside a scope is a
+ * violation. Each violation is counted and the first few are kept with
+ * their scope label and a backtrace, printed at exit or on request.
+ * LUVLANG_RT_AUDIT=abort in the environment aborts on the first one
+ * instead, with the report on stderr.
+ *
+ * Other threads are not affected, so the main thread may construct,
+ * resize and free while the audio thread is audited. In normal builds
+ * RealtimeScope is empty and every call below compiles to nothing.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// AUDIT STATE
+// ═══════════════════════════════════════════════════════════════════════════
+
+enum RealtimeAuditMode {
+    REALTIME_AUDIT_COUNT = 0,  // Count and record, keep running (default)
+    REALTIME_AUDIT_ABORT       // Print the report and abort on the first violation
+};
+
+constexpr int REALTIME_AUDIT_MAX_RECORDS = 8;
+
+// One trapped allocation. Strings and frames stay valid for the process.
+struct RealtimeAuditRecord {
+    const char* scope = nullptr;     // Innermost RealtimeScope label
+    const char* function = nullptr;  // "operator new", "malloc", ...
+    size_t bytes = 0;
+    int frameCount = 0;              // Backtrace depth (0 where unavailable)
+    void* frames[16] = {};
+};
+
+#if defined(LUVLANG_RT_AUDIT) && LUVLANG_RT_AUDIT
+
+// Marks the calling thread as realtime until destroyed. Scopes nest; the
+// innermost label is the one recorded.
+class RealtimeScope {
+public:
+    explicit RealtimeScope(const char* label);
+    ~RealtimeScope();
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+
+private:
+    const char* outerLabel;
+};
+
+constexpr bool REALTIME_AUDIT_ENABLED = true;
+
+void setRealtimeAuditMode(RealtimeAuditMode mode);
+uint64_t realtimeAuditViolations();
+
+// The first REALTIME_AUDIT_MAX_RECORDS violations since the last reset
+int realtimeAuditRecordCount();
+const RealtimeAuditRecord& realtimeAuditRecord(int index);
+
+// Clear the count and the records (tests)
+void resetRealtimeAudit();
+
+// Count, then every record with its backtrace (symbolised where the
+// binary exports its symbols)
+void printRealtimeAuditReport(FILE* out);
+
+#else
+
+class RealtimeScope {
+public:
+    explicit RealtimeScope(const char*) {}
+
+    RealtimeScope(const RealtimeScope&) = delete;
+    RealtimeScope& operator=(const RealtimeScope&) = delete;
+};
+
+constexpr bool REALTIME_AUDIT_ENABLED = false;
+
+inline void setRealtimeAuditMode(RealtimeAuditMode) {}
+inline uint64_t realtimeAuditViolations() { return 0; }
+inline int realtimeAuditRecordCount() { return 0; }
+inline const RealtimeAuditRecord& realtimeAuditRecord(int) {
+    static const RealtimeAuditRecord none;
+    return none;
+}
+inline void resetRealtimeAudit() {}
+inline void printRealtimeAuditReport(FILE*) {}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Stereo SIMD Lane Pair
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Double2 / Float2 hold one left/right sample pair (or one L/R filter state)
+ * in a single 128-bit register: wasm simd128 f64x2/f32x4, SSE2 __m128d/__m128
+ * or NEON float64x2_t/float32x2_t, with a plain two-lane fallback. Only
+ * lane-wise add, sub and mul are exposed, so results are bit-identical to the
+ * scalar code on every target (no FMA contraction through intrinsics).
+ * StereoPair<Sample> picks the one matching the chain's sample type.
+ *
+ * Define LUVLANG_NO_SIMD to force the scalar fallback.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#if defined(LUVLANG_NO_SIMD)
+// Scalar fallback only
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define LUVLANG_SIMD_WASM 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LUVLANG_SIMD_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define LUVLANG_SIMD_NEON 1
+#endif
+
+#if defined(LUVLANG_SIMD_SSE2)
+#include <xmmintrin.h>
+#endif
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DOUBLE2 (L/R lane pair)
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct Double2 {
+#if defined(LUVLANG_SIMD_WASM)
+    v128_t v;
+
+    Double2() : v(wasm_f64x2_splat(0.0)) {}
+    explicit Double2(v128_t value) : v(value) {}
+    Double2(double left, double right) : v(wasm_f64x2_make(left, right)) {}
+    static Double2 broadcast(double value) { return Double2(wasm_f64x2_splat(value)); }
+
+    double left() const { return wasm_f64x2_extract_lane(v, 0); }
+    double right() const { return wasm_f64x2_extract_lane(v, 1); }
+
+    friend Double2 operator+(Double2 a, Double2 b) { return Double2(wasm_f64x2_add(a.v, b.v)); }
+    friend Double2 operator-(Double2 a, Double2 b) { return Double2(wasm_f64x2_sub(a.v, b.v)); }
+    friend Double2 operator*(Double2 a, Double2 b) { return Double2(wasm_f64x2_mul(a.v, b.v)); }
+#elif defined(LUVLANG_SIMD_SSE2)
+    __m128d v;
+
+    Double2() : v(_mm_setzero_pd()) {}
+    explicit Double2(__m128d value) : v(value) {}
+    Double2(double left, double right) : v(_mm_set_pd(right, left)) {}
+    static Double2 broadcast(double value) { return Double2(_mm_set1_pd(value)); }
+
+    double left() const { return _mm_cvtsd_f64(v); }
+    double right() const { return _mm_cvtsd_f64(_mm_unpackhi_pd(v, v)); }
+
+    friend Double2 operator+(Double2 a, Double2 b) { return Double2(_mm_add_pd(a.v, b.v)); }
+    friend Double2 operator-(Double2 a, Double2 b) { return Double2(_mm_sub_pd(a.v, b.v)); }
+    friend Double2 operator*(Double2 a, Double2 b) { return Double2(_mm_mul_pd(a.v, b.v)); }
+#elif defined(LUVLANG_SIMD_NEON)
+    float64x2_t v;
+
+    Double2() : v(vdupq_n_f64(0.0)) {}
+    explicit Double2(float64x2_t value) : v(value) {}
+    Double2(double left, double right) : v(vsetq_lane_f64(right, vdupq_n_f64(left), 1)) {}
+    static Double2 broadcast(double value) { return Double2(vdupq_n_f64(value)); }
+
+    double left() const { return vgetq_lane_f64(v, 0); }
+    double right() const { return vgetq_lane_f64(v, 1); }
+
+    friend Double2 operator+(Double2 a, Double2 b) { return Double2(vaddq_f64(a.v, b.v)); }
+    friend Double2 operator-(Double2 a, Double2 b) { return Double2(vsubq_f64(a.v, b.v)); }
+    friend Double2 operator*(Double2 a, Double2 b) { return Double2(vmulq_f64(a.v, b.v)); }
+#else
+    double l = 0.0;
+    double r = 0.0;
+
+    Double2() = default;
+    Double2(double left, double right) : l(left), r(right) {}
+    static Double2 broadcast(double value) { return Double2(value, value); }
+
+    double left() const { return l; }
+    double right() const { return r; }
+
+    friend Double2 operator+(Double2 a, Double2 b) { return Double2(a.l + b.l, a.r + b.r); }
+    friend Double2 operator-(Double2 a, Double2 b) { return Double2(a.l - b.l, a.r - b.r); }
+    friend Double2 operator*(Double2 a, Double2 b) { return Double2(a.l * b.l, a.r * b.r); }
+#endif
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FLOAT2 (L/R lane pair, float32 chain; lanes 2-3 unused)
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct Float2 {
+#if defined(LUVLANG_SIMD_WASM)
+    v128_t v;
+
+    Float2() : v(wasm_f32x4_splat(0.0f)) {}
+    explicit Float2(v128_t value) : v(value) {}
+    Float2(float left, float right) : v(wasm_f32x4_make(left, right, 0.0f, 0.0f)) {}
+    static Float2 broadcast(float value) { return Float2(wasm_f32x4_splat(value)); }
+
+    float left() const { return wasm_f32x4_extract_lane(v, 0); }
+    float right() const { return wasm_f32x4_extract_lane(v, 1); }
+
+    friend Float2 operator+(Float2 a, Float2 b) { return Float2(wasm_f32x4_add(a.v, b.v)); }
+    friend Float2 operator-(Float2 a, Float2 b) { return Float2(wasm_f32x4_sub(a.v, b.v)); }
+    friend Float2 operator*(Float2 a, Float2 b) { return Float2(wasm_f32x4_mul(a.v, b.v)); }
+#elif defined(LUVLANG_SIMD_SSE2)
+    __m128 v;
+
+    Float2() : v(_mm_setzero_ps()) {}
+    explicit Float2(__m128 value) : v(value) {}
+    Float2(float left, float right) : v(_mm_set_ps(0.0f, 0.0f, right, left)) {}
+    static Float2 broadcast(float value) { return Float2(_mm_set1_ps(value)); }
+
+    float left() const { return _mm_cvtss_f32(v); }
+    float right() const { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))); }
+
+    friend Float2 operator+(Float2 a, Float2 b) { return Float2(_mm_add_ps(a.v, b.v)); }
+    friend Float2 operator-(Float2 a, Float2 b) { return Float2(_mm_sub_ps(a.v, b.v)); }
+    friend Float2 operator*(Float2 a, Float2 b) { return Float2(_mm_mul_ps(a.v, b.v)); }
+#elif defined(LUVLANG_SIMD_NEON)
+    float32x2_t v;
+
+    Float2() : v(vdup_n_f32(0.0f)) {}
+    explicit Float2(float32x2_t value) : v(value) {}
+    Float2(float left, float right) : v(vset_lane_f32(right, vdup_n_f32(left), 1)) {}
+    static Float2 broadcast(float value) { return Float2(vdup_n_f32(value)); }
+
+    float left() const { return vget_lane_f32(v, 0); }
+    float right() const { return vget_lane_f32(v, 1); }
+
+    friend Float2 operator+(Float2 a, Float2 b) { return Float2(vadd_f32(a.v, b.v)); }
+    friend Float2 operator-(Float2 a, Float2 b) { return Float2(vsub_f32(a.v, b.v)); }
+    friend Float2 operator*(Float2 a, Float2 b) { return Float2(vmul_f32(a.v, b.v)); }
+#else
+    float l = 0.0f;
+    float r = 0.0f;
+
+    Float2() = default;
+    Float2(float left, float right) : l(left), r(right) {}
+    static Float2 broadcast(float value) { return Float2(value, value); }
+
+    float left() const { return l; }
+    float right() const { return r; }
+
+    friend Float2 operator+(Float2 a, Float2 b) { return Float2(a.l + b.l, a.r + b.r); }
+    friend Float2 operator-(Float2 a, Float2 b) { return Float2(a.l - b.l, a.r - b.r); }
+    friend Float2 operator*(Float2 a, Float2 b) { return Float2(a.l * b.l, a.r * b.r); }
+#endif
+};
+
+// Lane pair for the chain's sample type
+template <typename Sample>
+using StereoPair = std::conditional_t<std::is_same_v<Sample, float>, Float2, Double2>;
@@ -0,0 +1,94 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Sample Rate Converter
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Offline windowed-sinc resampling utility.
+ */
+
+#pragma once
+
+#include "ConstexprMath.h"
+#include "DSPCommon.h"
+
+#include <array>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SAMPLE RATE CONVERTER (High-Quality Sinc Interpolation)
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Blackman-windowed sinc, built by the compiler and shared by every converter
+namespace SampleRateConverterDetail {
+
+constexpr int SINC_TAPS = 128;
+
+constexpr std::array<double, SINC_TAPS> generateSincTable() {
+    std::array<double, SINC_TAPS> table{};
+    for (int i = 0; i < SINC_TAPS; ++i) {
+        int n = i - SINC_TAPS / 2;
+        double x = n * 0.5;
+
+        // Windowed sinc
+        double sinc = (x == 0.0) ? 1.0 : ConstexprMath::sin(PI * x) / (PI * x);
+
+        // Blackman window
+        double window = 0.42 - 0.5 * ConstexprMath::cos(2.0 * PI * i / (SINC_TAPS - 1))
+                      + 0.08 * ConstexprMath::cos(4.0 * PI * i / (SINC_TAPS - 1));
+
+        table[i] = sinc * window;
+    }
+    return table;
+}
+
+}  // namespace SampleRateConverterDetail
+
+class SampleRateConverter {
+private:
+    constexpr static int SINC_TAPS = SampleRateConverterDetail::SINC_TAPS;
+    constexpr static std::array<double, SINC_TAPS> SINC_TABLE = SampleRateConverterDetail::generateSincTable();
+    std::vector<double> inputBuffer;
+    int inputIndex = 0;
+
+public:
+    SampleRateConverter() {
+        inputBuffer.resize(SINC_TAPS, 0.0);
+    }
+
+    // Interpolate single sample at arbitrary position
+    double interpolate(const std::vector<double>& samples, double position) {
+        int baseIndex = static_cast<int>(position);
+        double fraction = position - baseIndex;
+
+        double sum = 0.0;
+        for (int i = 0; i < SINC_TAPS; ++i) {
+            int sampleIndex = baseIndex + i - SINC_TAPS / 2;
+            if (sampleIndex >= 0 && sampleIndex < static_cast<int>(samples.size())) {
+                sum += samples[sampleIndex] * SINC_TABLE[i];
+            }
+        }
+
+        return sum;
+    }
+
+    // Convert sample rate (e.g., 44.1kHz → 48kHz)
+    std::vector<double> convert(const std::vector<double>& input,
+                                double inputRate,
+                                double outputRate) {
+        double ratio = outputRate / inputRate;
+        int outputLength = static_cast<int>(input.size() * ratio);
+        std::vector<double> output(outputLength);
+
+        for (int i = 0; i < outputLength; ++i) {
+            double inputPos = i / ratio;
+            output[i] = interpolate(input, inputPos);
+        }
+
+        return output;
+    }
+
+    void reset() {
+        std::fill(inputBuffer.begin(), inputBuffer.end(), 0.0);
+        inputIndex = 0;
+    }
+};
@@ -0,0 +1,98 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Mid-Side Processing and Stereo Imager
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Frequency-dependent width with mono-bass below the low crossover.
+ */
+
+#pragma once
+
+#include "Crossover.h"
+#include "DSPCommon.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MID-SIDE (M/S) PROCESSOR
+// ═══════════════════════════════════════════════════════════════════════════
+
+class MidSideProcessor {
+public:
+    template <typename Sample>
+    static inline void encode(Sample L, Sample R, Sample& M, Sample& S) {
+        M = (L + R) * Sample(0.5);
+        S = (L - R) * Sample(0.5);
+    }
+
+    template <typename Sample>
+    static inline void decode(Sample M, Sample S, Sample& L, Sample& R) {
+        L = M + S;
+        R = M - S;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FREQUENCY-DEPENDENT STEREO WIDENER
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample>
+class StereoImager {
+private:
+    using Pair = StereoPair<Sample>;
+
+    ThreeBandCrossover<Sample> crossover;
+    double widthAmount = 1.0;
+    ParameterSmoother widthSmoother;
+
+public:
+    StereoImager() {
+        widthSmoother.setImmediate(1.0);
+    }
+
+    void setSampleRate(double sr) {
+        crossover.setSampleRate(sr);
+        widthSmoother.setSmoothTime(50.0, sr);
+    }
+
+    void setWidth(double width) {
+        widthAmount = std::max(0.0, std::min(2.0, width));
+        widthSmoother.setTarget(widthAmount);
+    }
+
+    void processStereo(Sample& L, Sample& R) {
+        Sample width = static_cast<Sample>(widthSmoother.getSmoothed());
+
+        Pair low, mid, high;
+        crossover.process(Pair(L, R), low, mid, high);
+        Sample lowL = low.left(), midL = mid.left(), highL = high.left();
+        Sample lowR = low.right(), midR = mid.right(), highR = high.right();
+
+        // LOW: 100% MONO
+        Sample lowMono = (lowL + lowR) * Sample(0.5);
+        lowL = lowR = lowMono;
+
+        // MID: 50% of width
+        Sample midM, midS;
+        MidSideProcessor::encode(midL, midR, midM, midS);
+        midS *= (Sample(0.5) * width);
+        MidSideProcessor::decode(midM, midS, midL, midR);
+
+        // HIGH: 100% of width
+        Sample highM, highS;
+        MidSideProcessor::encode(highL, highR, highM, highS);
+        highS *= width;
+        MidSideProcessor::decode(highM, highS, highL, highR);
+
+        L = lowL + midL + highL;
+        R = lowR + midR + highR;
+    }
+
+    void processBlock(Sample* left, Sample* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            processStereo(left[i], right[i]);
+        }
+    }
+
+    void reset() {
+        crossover.reset();
+    }
+};
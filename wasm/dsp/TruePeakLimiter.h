@@ -0,0 +1,518 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Oversampler and True-Peak Limiter
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Polyphase FIR oversampling (compile-time factor and quality tier) and the
+ * true-peak limiter with Safe-Clip mode. The limiter can swap the FIR for
+ * the half-band IIR cascade (HalfBandOversampler.h) for low-latency
+ * monitoring.
+ */
+
+#pragma once
+
+#include "ConstexprMath.h"
+#include "CpuDispatch.h"
+#include "DSPCommon.h"
+#include "DSPKernels.h"
+#include "HalfBandOversampler.h"
+#include "SIMD.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OVERSAMPLING QUALITY TIERS
+// ═══════════════════════════════════════════════════════════════════════════
+// Factor and FIR length are template parameters of Oversampler and
+// TruePeakLimiter (and, through them, MasteringEngineT), so every tier gets
+// its own fully-sized inner loops with no runtime branches. All three named
+// tiers keep 16 taps per phase; longer filters give a narrower transition
+// band at the higher factors.
+
+template <int Factor, int TapCount>
+struct OversamplingQuality {
+    constexpr static int FACTOR = Factor;
+    constexpr static int TAP_COUNT = TapCount;
+};
+
+// Browser preview while the user is tweaking
+struct RealtimePreviewQuality : OversamplingQuality<2, 32> {
+    constexpr static const char* NAME = "realtime preview";
+};
+
+// Browser playback and the default engine
+struct StandardQuality : OversamplingQuality<4, 64> {
+    constexpr static const char* NAME = "standard";
+};
+
+// Offline server render (luvlang-master)
+struct ExportQuality : OversamplingQuality<8, 128> {
+    constexpr static const char* NAME = "export";
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// POLYPHASE FIR OVERSAMPLER (stereo lane pair)
+// ═══════════════════════════════════════════════════════════════════════════
+// One TapCount-tap Blackman-windowed sinc, centred on tap TapCount/2 so the
+// delay is a whole number of samples. Its zeros fall exactly on every
+// Factor-th tap (a Nyquist filter), so phase 0 of the interpolator passes
+// the input through and the other phases produce the true inter-sample
+// values.
+//
+// Upsampling runs each phase's TAPS_PER_PHASE taps over the input history;
+// downsampling runs the full filter once per Factor oversampled inputs. Up
+// and down keep separate histories, each stored twice over (every write
+// lands at i and i + N) so the N most recent samples are always one
+// contiguous run and the dot product needs no wrap or modulo. L/R share a
+// SIMD lane pair, so each multiply-add serves both channels.
+//
+// The dot products are the DSPKernels.h FIR bank. The double-precision
+// quality tiers (16 taps per phase at 2x / 4x / 8x) call it through the
+// runtime-dispatched table, so AVX2 / AVX-512 machines run two or four
+// phases per instruction; other configurations inline the baseline body.
+
+template <typename Sample, int Factor, int TapCount>
+class Oversampler {
+public:
+    using Pair = StereoPair<Sample>;
+    using Frame = std::array<Pair, Factor>;
+
+    constexpr static int TAPS_PER_PHASE = TapCount / Factor;
+
+    // Integer group delay of upsample() followed by downsample(), in input samples
+    constexpr static int LATENCY_SAMPLES = TapCount / Factor;
+
+private:
+    static_assert(TapCount % Factor == 0, "taps must split evenly into phases");
+    static_assert((TAPS_PER_PHASE & (TAPS_PER_PHASE - 1)) == 0, "ring length must be a power of two");
+    static_assert((TapCount & (TapCount - 1)) == 0, "ring length must be a power of two");
+    static_assert(TapCount % 4 == 0, "downsampling runs four partial sums");
+
+    constexpr static bool DISPATCHED = std::is_same_v<Sample, double> && TAPS_PER_PHASE == 16 &&
+                                       (Factor == 2 || Factor == 4 || Factor == 8);
+    constexpr static int KERNEL_INDEX = Factor == 2 ? 0 : (Factor == 4 ? 1 : 2);
+
+    std::array<Pair, 2 * TAPS_PER_PHASE> upHistory;
+    std::array<Pair, 2 * TapCount> downHistory;
+    int upIndex = 0;
+    int downIndex = 0;
+
+    // Entry points from dspKernels(), taken once at construction
+    FIRKernelF64 upKernel = nullptr;
+    FIRKernelF64 downKernel = nullptr;
+
+    constexpr static double prototypeTap(int i) {
+        int n = i - TapCount / 2;
+        double sinc = 0.0;
+        if (n == 0) {
+            sinc = 1.0;
+        } else if (n % Factor == 0) {
+            sinc = 0.0;  // Exact zero crossing
+        } else {
+            double x = PI * n / Factor;
+            sinc = ConstexprMath::sin(x) / x;
+        }
+        double window = 0.42 - 0.5 * ConstexprMath::cos(2.0 * PI * i / TapCount)
+                      + 0.08 * ConstexprMath::cos(4.0 * PI * i / TapCount);
+        return sinc * window / Factor;
+    }
+
+    // Both tables hold each tap once per lane (DSPKernels.h layout)
+    struct Coefficients {
+        std::array<Sample, 2 * TapCount> up{};    // Factor * h[p + Factor*k] at (k * Factor + p) * 2
+        std::array<Sample, 2 * TapCount> down{};  // h[j] at j * 2
+    };
+
+    constexpr static Coefficients generateFIRCoeffs() {
+        Coefficients c;
+        for (int i = 0; i < TapCount; ++i) {
+            double h = prototypeTap(i);
+            int phase = i % Factor;
+            int k = i / Factor;
+            for (int lane = 0; lane < 2; ++lane) {
+                c.down[i * 2 + lane] = static_cast<Sample>(h);
+                c.up[(k * Factor + phase) * 2 + lane] = static_cast<Sample>(h * Factor);
+            }
+        }
+        return c;
+    }
+
+    // One read-only table per (Sample, Factor, TapCount), built by the
+    // compiler and shared by every instance
+    constexpr static Coefficients COEFFS = generateFIRCoeffs();
+
+    inline void pushDown(Pair value) {
+        downIndex = (downIndex - 1) & (TapCount - 1);
+        downHistory[downIndex] = value;
+        downHistory[downIndex + TapCount] = value;
+    }
+
+public:
+    Oversampler() {
+        if constexpr (DISPATCHED) {
+            upKernel = dspKernels().firUpsampleF64[KERNEL_INDEX];
+            downKernel = dspKernels().firDownsampleF64[KERNEL_INDEX];
+        }
+        reset();
+    }
+
+    // One input frame in, Factor frames out (oldest first)
+    inline void upsample(Pair input, Frame& output) {
+        upIndex = (upIndex - 1) & (TAPS_PER_PHASE - 1);
+        upHistory[upIndex] = input;
+        upHistory[upIndex + TAPS_PER_PHASE] = input;
+
+        const Pair* x = &upHistory[upIndex];  // x[k] = input k samples ago
+        if constexpr (DISPATCHED) {
+            upKernel(reinterpret_cast<const double*>(x), COEFFS.up.data(), reinterpret_cast<double*>(output.data()));
+        } else {
+            DSPKernels::firUpsample<Sample, Factor, TAPS_PER_PHASE>(x, COEFFS.up.data(), output.data());
+        }
+    }
+
+    // Factor frames in (oldest first), one frame out. The
+    // output is taken at phase 0, the phase the interpolator passes
+    // through, so the round trip delay is a whole number of samples
+    inline Pair downsample(const Frame& input) {
+        pushDown(input[0]);
+
+        const Pair* x = &downHistory[downIndex];
+        Pair sum;
+        if constexpr (DISPATCHED) {
+            downKernel(reinterpret_cast<const double*>(x), COEFFS.down.data(), reinterpret_cast<double*>(&sum));
+        } else {
+            sum = DSPKernels::firDownsample<Sample, TapCount>(x, COEFFS.down.data());
+        }
+
+        for (int i = 1; i < Factor; ++i) {
+            pushDown(input[i]);
+        }
+        return sum;
+    }
+
+    void reset() {
+        upHistory.fill(Pair());
+        downHistory.fill(Pair());
+        upIndex = 0;
+        downIndex = 0;
+    }
+};
+
+// 1x: sample-peak detection, no filtering and no delay
+template <typename Sample, int TapCount>
+class Oversampler<Sample, 1, TapCount> {
+public:
+    using Pair = StereoPair<Sample>;
+    using Frame = std::array<Pair, 1>;
+
+    constexpr static int LATENCY_SAMPLES = 0;
+
+    inline void upsample(Pair input, Frame& output) { output[0] = input; }
+    inline Pair downsample(const Frame& input) { return input[0]; }
+    void reset() {}
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SLIDING-WINDOW MAXIMUM (monotonic deque)
+// ═══════════════════════════════════════════════════════════════════════════
+// Maximum of the last `window` values pushed, O(1) amortized per push: the
+// deque keeps only values that can still become the maximum, in decreasing
+// order, so each value is pushed and popped at most once. The ring is
+// allocated once for the largest window; setWindow() never allocates.
+
+template <typename Sample>
+class SlidingWindowMax {
+    struct Entry {
+        uint32_t index;
+        Sample value;
+    };
+
+    // Power-of-two ring addressed by free-running counters (wrap-safe)
+    std::vector<Entry> entries;
+    uint32_t mask = 0;
+    uint32_t window = 1;
+    uint32_t head = 0;
+    uint32_t tail = 0;
+    uint32_t pushed = 0;
+
+public:
+    explicit SlidingWindowMax(int maxWindow = 1) {
+        uint32_t capacity = 1;
+        while (capacity < static_cast<uint32_t>(std::max(maxWindow, 1))) capacity <<= 1;
+        entries.assign(capacity, Entry{0, Sample(0)});
+        mask = capacity - 1;
+    }
+
+    // Clamped to the capacity given at construction; clears the window
+    void setWindow(int windowSize) {
+        window = std::min(static_cast<uint32_t>(std::max(windowSize, 1)), mask + 1);
+        reset();
+    }
+
+    // Adds a value and returns the maximum of the window ending with it
+    inline Sample push(Sample value) {
+        if (head != tail && pushed - entries[head & mask].index >= window) head++;
+        while (head != tail && entries[(tail - 1) & mask].value <= value) tail--;
+        entries[tail++ & mask] = Entry{pushed++, value};
+        return entries[head & mask].value;
+    }
+
+    void reset() {
+        head = 0;
+        tail = 0;
+        pushed = 0;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TRUE-PEAK LIMITER with SAFE-CLIP MODE
+// ═══════════════════════════════════════════════════════════════════════════
+// Detection runs through either the tier's linear-phase FIR or, for live
+// monitoring, the half-band IIR cascade at the same factor. The choice is
+// per instance and taken once per call, outside the per-sample loop.
+//
+// Look-ahead: each oversampled frame waits lookAheadSize frames in a delay
+// ring while its true peak is already in the gain computer. The gain
+// request (threshold / peak) is held by a sliding-window maximum over
+// lookAheadSize + 1 frames, then averaged over the same span, so gain
+// falls in a linear ramp that reaches the peak's full reduction exactly
+// when the peak leaves the delay ring. Release is the exponential
+// envelope on top. The delayed frame is then gained (or safe-clipped) and
+// downsampled, so the look-ahead is the latency the limiter already had.
+// The delay line is allocated once for MAX_LOOKAHEAD_MS at MAX_SAMPLE_RATE,
+// so changing the rate or the look-ahead time never allocates.
+
+enum OversamplingFilter {
+    OVERSAMPLING_LINEAR_PHASE_FIR,
+    OVERSAMPLING_HALF_BAND_IIR
+};
+
+template <typename Sample, typename Quality = StandardQuality>
+class TruePeakLimiter {
+public:
+    using OversamplerType = Oversampler<Sample, Quality::FACTOR, Quality::TAP_COUNT>;
+    using HalfBandType = HalfBandOversampler<Sample, Quality::FACTOR>;
+
+private:
+    using Pair = StereoPair<Sample>;
+    constexpr static int FACTOR = Quality::FACTOR;
+
+    double threshold;
+    Sample thresholdLinear;
+    double release;
+    Sample releaseCoeff;
+    constexpr static int MAX_LOOKAHEAD_FRAMES = static_cast<int>(MAX_LOOKAHEAD_MS * 0.001 * MAX_SAMPLE_RATE);
+
+    // Look-ahead delay line, one slot per frame in the window
+    double lookAheadMs = DEFAULT_LOOKAHEAD_MS;
+    int lookAheadSize = -1;  // Set by updateLookAhead()
+    int windowSize = 1;      // lookAheadSize + 1
+    int writeSlot = 0;
+    std::vector<std::array<Pair, FACTOR>> delayedFrames;
+    std::vector<Sample> delayedPeaks;
+    std::vector<Sample> heldGains;  // Held gain request per frame, for the ramp average
+    double heldGainSum = 0.0;
+    SlidingWindowMax<Sample> peakHold;
+    Sample envelope = 1;
+    double truePeakHold = 0.0;  // Output true peak (oversampled), max since reset
+    double sampleRate;
+    OversamplerType oversampler;  // L/R lane pair
+    HalfBandType halfBandOversampler;
+    OversamplingFilter oversamplingFilter = OVERSAMPLING_LINEAR_PHASE_FIR;
+
+    // SAFE-CLIP MODE
+    bool safeClipMode = false;  // false = transparent limiting, true = aggressive clipping
+
+    template <typename Over>
+    inline void processFrame(Over& over, Sample& left, Sample& right) {
+        typename Over::Frame up;
+        over.upsample(Pair(left, right), up);
+
+        Sample truePeak = 0;
+        for (int i = 0; i < FACTOR; ++i) {
+            truePeak = std::max(truePeak, std::max(std::abs(up[i].left()), std::abs(up[i].right())));
+        }
+
+        // Queue the frame; the slot after it holds the frame lookAheadSize
+        // frames older (the same slot when there is no look-ahead)
+        int slot = writeSlot;
+        delayedFrames[slot] = up;
+        delayedPeaks[slot] = truePeak;
+        writeSlot = slot + 1 == windowSize ? 0 : slot + 1;
+
+        Sample heldPeak = peakHold.push(truePeak);
+        Sample heldGain = heldPeak > thresholdLinear ? thresholdLinear / heldPeak : Sample(1);
+        heldGainSum += static_cast<double>(heldGain) - static_cast<double>(heldGains[slot]);
+        heldGains[slot] = heldGain;
+
+        // Attack ramp, release envelope, and an exact cap from the outgoing
+        // frame's own peak (the ramp average can round an ulp high)
+        Sample ramp = static_cast<Sample>(heldGainSum / windowSize);
+        envelope = std::min(ramp, envelope * releaseCoeff + ramp * (Sample(1) - releaseCoeff));
+        Sample outgoingPeak = delayedPeaks[writeSlot];
+        if (outgoingPeak > thresholdLinear) {
+            envelope = std::min(envelope, thresholdLinear / outgoingPeak);
+        }
+
+        // The outgoing slot is free until the next frame, so gain it in place
+        auto& delayed = delayedFrames[writeSlot];
+        Sample limitedPeak = 0;
+        if (safeClipMode) {
+            // SAFE-CLIP MODE: Aggressive hard-clipping (Loudness War style)
+            for (int i = 0; i < FACTOR; ++i) {
+                delayed[i] = Pair(hardClip(delayed[i].left(), thresholdLinear),
+                             hardClip(delayed[i].right(), thresholdLinear));
+                limitedPeak = std::max(limitedPeak, std::max(std::abs(delayed[i].left()), std::abs(delayed[i].right())));
+            }
+        } else {
+            // TRANSPARENT MODE: Soft limiting (the ramp has reached this frame's peak)
+            Pair gain = Pair::broadcast(envelope);
+            for (int i = 0; i < FACTOR; ++i) {
+                delayed[i] = delayed[i] * gain;
+                limitedPeak = std::max(limitedPeak, std::max(std::abs(delayed[i].left()), std::abs(delayed[i].right())));
+            }
+        }
+        truePeakHold = std::max(truePeakHold, static_cast<double>(limitedPeak));
+
+        Pair output = over.downsample(delayed);
+        left = output.left();
+        right = output.right();
+    }
+
+    // Look-ahead time -> frames at the current rate; restarts the delay
+    // line only when the length actually changes
+    void updateLookAhead() {
+        int frames = std::min(static_cast<int>(std::lround(lookAheadMs * 0.001 * sampleRate)),
+                              MAX_LOOKAHEAD_FRAMES);
+        if (frames == lookAheadSize) return;
+        lookAheadSize = frames;
+        windowSize = frames + 1;
+        peakHold.setWindow(windowSize);
+        resetLookAhead();
+    }
+
+    void resetLookAhead() {
+        std::array<Pair, FACTOR> silence;
+        silence.fill(Pair());
+        std::fill(delayedFrames.begin(), delayedFrames.begin() + windowSize, silence);
+        std::fill(delayedPeaks.begin(), delayedPeaks.begin() + windowSize, Sample(0));
+        std::fill(heldGains.begin(), heldGains.begin() + windowSize, Sample(1));
+        heldGainSum = windowSize;
+        peakHold.reset();
+        writeSlot = 0;
+        envelope = 1;
+    }
+
+public:
+    TruePeakLimiter(double sr = 48000.0)
+        : delayedFrames(MAX_LOOKAHEAD_FRAMES + 1),
+          delayedPeaks(MAX_LOOKAHEAD_FRAMES + 1),
+          heldGains(MAX_LOOKAHEAD_FRAMES + 1),
+          peakHold(MAX_LOOKAHEAD_FRAMES + 1),
+          sampleRate(sr) {
+        updateLookAhead();
+        setThreshold(-1.0);
+        setRelease(0.05);
+    }
+
+    // Above MAX_SAMPLE_RATE the look-ahead is capped at MAX_LOOKAHEAD_FRAMES
+    void setSampleRate(double sr) {
+        sampleRate = sr;
+        updateLookAhead();
+        setRelease(release);
+    }
+
+    // Look-ahead (and attack ramp) time, 0 .. MAX_LOOKAHEAD_MS. Changes
+    // getLatencySamples() and restarts the delay line from silence.
+    void setLookAhead(double ms) {
+        lookAheadMs = std::max(0.0, std::min(ms, MAX_LOOKAHEAD_MS));
+        updateLookAhead();
+    }
+
+    double getLookAhead() const {
+        return lookAheadMs;
+    }
+
+    int getLookAheadSamples() const {
+        return lookAheadSize;
+    }
+
+    void setThreshold(double thresholdDB) {
+        threshold = thresholdDB;
+        thresholdLinear = static_cast<Sample>(dbToLinear(thresholdDB));
+    }
+
+    void setRelease(double releaseSec) {
+        release = releaseSec;
+        releaseCoeff = static_cast<Sample>(std::exp(-1.0 / (release * sampleRate)));
+    }
+
+    void setSafeClipMode(bool enabled) {
+        safeClipMode = enabled;
+    }
+
+    // Switching starts the newly selected filter from silence
+    void setOversamplingFilter(OversamplingFilter filter) {
+        if (filter == oversamplingFilter) return;
+        oversamplingFilter = filter;
+        oversampler.reset();
+        halfBandOversampler.reset();
+    }
+
+    OversamplingFilter getOversamplingFilter() const {
+        return oversamplingFilter;
+    }
+
+    // Delay added by the selected oversampling filter, in samples
+    int getOversamplingLatency() const {
+        return oversamplingFilter == OVERSAMPLING_HALF_BAND_IIR
+            ? halfBandOversampler.getLatencySamples()
+            : OversamplerType::LATENCY_SAMPLES;
+    }
+
+    // Input-to-output delay: the look-ahead plus the oversampler round
+    // trip (exact for the FIR; the half-band cascade's low-frequency group
+    // delay, rounded)
+    int getLatencySamples() const {
+        return lookAheadSize + getOversamplingLatency();
+    }
+
+    void processStereo(Sample& left, Sample& right) {
+        if (oversamplingFilter == OVERSAMPLING_HALF_BAND_IIR) {
+            processFrame(halfBandOversampler, left, right);
+        } else {
+            processFrame(oversampler, left, right);
+        }
+    }
+
+    void processBlock(Sample* left, Sample* right, int numSamples) {
+        if (oversamplingFilter == OVERSAMPLING_HALF_BAND_IIR) {
+            for (int i = 0; i < numSamples; ++i) {
+                processFrame(halfBandOversampler, left[i], right[i]);
+            }
+        } else {
+            for (int i = 0; i < numSamples; ++i) {
+                processFrame(oversampler, left[i], right[i]);
+            }
+        }
+    }
+
+    double getGainReduction() {
+        return linearToDb(static_cast<double>(envelope));
+    }
+
+    double getTruePeak() {
+        return linearToDb(truePeakHold);
+    }
+
+    void reset() {
+        resetLookAhead();
+        truePeakHold = 0.0;
+        oversampler.reset();
+        halfBandOversampler.reset();
+    }
+};
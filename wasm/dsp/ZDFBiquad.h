@@ -0,0 +1,220 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Zero-Delay Feedback Biquad
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Topology-preserving state-variable filter with Nyquist de-cramping,
+ * plus the stereo-pair SIMD variant used by the filter-heavy stages.
+ * Coefficients are always designed in double; the filters run in Sample.
+ */
+
+#pragma once
+
+#include "DSPCommon.h"
+#include "SIMD.h"
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ZDF COEFFICIENT DESIGN
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct ZDFDesign {
+    enum FilterType {
+        LOWPASS,
+        HIGHPASS,
+        BANDPASS,
+        BELL,
+        LOWSHELF,
+        HIGHSHELF,
+        NOTCH
+    };
+
+    struct Coefficients {
+        double a1, a2, a3;
+        double m0, m1, m2;
+    };
+
+    static Coefficients design(double freq, double Q, double gainDB, FilterType type, double sampleRate) {
+        Coefficients c;
+        double g = std::tan(PI * freq / sampleRate);
+        double k = 1.0 / Q;
+        double A = dbToLinear(gainDB);
+
+        c.a1 = 1.0 / (1.0 + g * (g + k));
+        c.a2 = g * c.a1;
+        c.a3 = g * c.a2;
+
+        switch (type) {
+            case LOWPASS:
+                c.m0 = 0.0;
+                c.m1 = 0.0;
+                c.m2 = 1.0;
+                break;
+
+            case HIGHPASS:
+                c.m0 = 1.0;
+                c.m1 = -k;
+                c.m2 = -1.0;
+                break;
+
+            case BANDPASS:
+                c.m0 = 0.0;
+                c.m1 = 1.0;
+                c.m2 = 0.0;
+                break;
+
+            case BELL:
+                c.m0 = 1.0;
+                c.m1 = k * (A * A - 1.0);
+                c.m2 = 0.0;
+                break;
+
+            case LOWSHELF:
+                c.m0 = 1.0;
+                c.m1 = k * (A - 1.0);
+                c.m2 = A * A - 1.0;
+                break;
+
+            case HIGHSHELF:
+                c.m0 = A * A;
+                c.m1 = k * (1.0 - A) * A;
+                c.m2 = 1.0 - A * A;
+                break;
+
+            case NOTCH:
+                c.m0 = 1.0;
+                c.m1 = -k;
+                c.m2 = 0.0;
+                break;
+        }
+        return c;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ZDF BIQUAD FILTER (Zero-Delay Feedback with Nyquist De-cramping)
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Sample>
+class ZDFBiquad {
+private:
+    Sample a1, a2, a3;
+    Sample m0, m1, m2;
+    Sample ic1eq = 0;
+    Sample ic2eq = 0;
+    double sampleRate;
+
+public:
+    ZDFBiquad() : sampleRate(48000.0) {
+        setCoefficients(1000.0, 0.707, 0.0, ZDFDesign::BELL);
+    }
+
+    void setSampleRate(double sr) {
+        sampleRate = sr;
+    }
+
+    void setCoefficients(double freq, double Q, double gainDB, ZDFDesign::FilterType type) {
+        ZDFDesign::Coefficients c = ZDFDesign::design(freq, Q, gainDB, type, sampleRate);
+        a1 = static_cast<Sample>(c.a1);
+        a2 = static_cast<Sample>(c.a2);
+        a3 = static_cast<Sample>(c.a3);
+        m0 = static_cast<Sample>(c.m0);
+        m1 = static_cast<Sample>(c.m1);
+        m2 = static_cast<Sample>(c.m2);
+    }
+
+    inline Sample process(Sample input) {
+        Sample v3 = input - ic2eq;
+        Sample v1 = a1 * ic1eq + a2 * v3;
+        Sample v2 = ic2eq + a2 * ic1eq + a3 * v3;
+        ic1eq = Sample(2) * v1 - ic1eq;
+        ic2eq = Sample(2) * v2 - ic2eq;
+        return m0 * input + m1 * v1 + m2 * v2;
+    }
+
+    // Fixed coefficients over the block; state stays in registers
+    void processBlock(Sample* samples, int numSamples) {
+        Sample s1 = ic1eq, s2 = ic2eq;
+        for (int i = 0; i < numSamples; ++i) {
+            Sample input = samples[i];
+            Sample v3 = input - s2;
+            Sample v1 = a1 * s1 + a2 * v3;
+            Sample v2 = s2 + a2 * s1 + a3 * v3;
+            s1 = Sample(2) * v1 - s1;
+            s2 = Sample(2) * v2 - s2;
+            samples[i] = m0 * input + m1 * v1 + m2 * v2;
+        }
+        ic1eq = s1;
+        ic2eq = s2;
+    }
+
+    void reset() {
+        ic1eq = 0;
+        ic2eq = 0;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// STEREO ZDF BIQUAD (L/R state in one SIMD register)
+// ═══════════════════════════════════════════════════════════════════════════
+// Replaces a pair of identically-tuned ZDFBiquads: one coefficient design,
+// one instruction stream for both channels, bit-identical per lane.
+
+template <typename Sample>
+class StereoZDFBiquad {
+public:
+    using Pair = StereoPair<Sample>;
+
+private:
+    Pair a1, a2, a3;
+    Pair m0, m1, m2;
+    Pair ic1eq, ic2eq;
+    Pair two = Pair::broadcast(Sample(2));
+    double sampleRate;
+
+public:
+    StereoZDFBiquad() : sampleRate(48000.0) {
+        setCoefficients(1000.0, 0.707, 0.0, ZDFDesign::BELL);
+    }
+
+    void setSampleRate(double sr) {
+        sampleRate = sr;
+    }
+
+    void setCoefficients(double freq, double Q, double gainDB, ZDFDesign::FilterType type) {
+        ZDFDesign::Coefficients c = ZDFDesign::design(freq, Q, gainDB, type, sampleRate);
+        a1 = Pair::broadcast(static_cast<Sample>(c.a1));
+        a2 = Pair::broadcast(static_cast<Sample>(c.a2));
+        a3 = Pair::broadcast(static_cast<Sample>(c.a3));
+        setMixCoefficients(c.m0, c.m1, c.m2);
+    }
+
+    // Output mix only (m0/m1/m2); the a-terms depend on frequency and Q alone,
+    // so a gain change on a BELL band never needs a full redesign
+    void setMixCoefficients(double newM0, double newM1, double newM2) {
+        m0 = Pair::broadcast(static_cast<Sample>(newM0));
+        m1 = Pair::broadcast(static_cast<Sample>(newM1));
+        m2 = Pair::broadcast(static_cast<Sample>(newM2));
+    }
+
+    inline Pair process(Pair input) {
+        Pair v3 = input - ic2eq;
+        Pair v1 = a1 * ic1eq + a2 * v3;
+        Pair v2 = ic2eq + a2 * ic1eq + a3 * v3;
+        ic1eq = two * v1 - ic1eq;
+        ic2eq = two * v2 - ic2eq;
+        return m0 * input + m1 * v1 + m2 * v2;
+    }
+
+    void processBlock(Sample* left, Sample* right, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            Pair output = process(Pair(left[i], right[i]));
+            left[i] = output.left();
+            right[i] = output.right();
+        }
+    }
+
+    void reset() {
+        ic1eq = Pair();
+        ic2eq = Pair();
+    }
+};
@@ -0,0 +1,28 @@
+/*
+ * Shared check harness for the DSP tests
+ * check() counts a value against an inclusive range and prints failures;
+ * testSummary() prints the totals and returns main()'s exit code.
+ */
+
+#pragma once
+
+#include <cstdio>
+
+inline int passedChecks = 0;
+inline int failedChecks = 0;
+
+inline bool check(const char* label, double value, double min, double max) {
+    bool pass = value >= min && value <= max;
+    if (pass) {
+        passedChecks++;
+    } else {
+        failedChecks++;
+        std::printf("  FAIL: %s = %.9g (expected %.9g to %.9g)\n", label, value, min, max);
+    }
+    return pass;
+}
+
+inline int testSummary() {
+    std::printf("\n%d passed, %d failed\n", passedChecks, failedChecks);
+    return failedChecks == 0 ? 0 : 1;
+}
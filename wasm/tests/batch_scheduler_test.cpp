@@ -0,0 +1,110 @@
+/*
+ * Batch scheduler test
+ * Work-stealing pool runs every job exactly once, never exceeds its worker
+ * count, rebalances a skewed deal; the I/O gate bounds concurrency.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "BatchScheduler.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// Track the peak number of callers inside a region
+struct ConcurrencyProbe {
+    std::atomic<int> current{0};
+    std::atomic<int> peak{0};
+
+    void enter() {
+        int now = current.fetch_add(1) + 1;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+    }
+    void leave() { current.fetch_sub(1); }
+};
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("Batch scheduler\n");
+    std::printf("========================================\n");
+
+    // Every job exactly once, across repeated batches on one pool
+    {
+        WorkStealingPool pool(4);
+        const size_t jobCount = 1000;
+        std::vector<size_t> order(jobCount);
+        std::iota(order.begin(), order.end(), 0);
+
+        for (int batch = 0; batch < 3; ++batch) {
+            std::vector<std::atomic<int>> runs(jobCount);
+            ConcurrencyProbe probe;
+            pool.run(order, [&](int worker, size_t job) {
+                probe.enter();
+                runs[job].fetch_add(1);
+                if (worker < 0 || worker >= 4) runs[job].fetch_add(100);
+                probe.leave();
+            });
+
+            int minRuns = 1000, maxRuns = 0;
+            for (auto& count : runs) {
+                minRuns = std::min(minRuns, count.load());
+                maxRuns = std::max(maxRuns, count.load());
+            }
+            check("pool:minRuns", minRuns, 1, 1);
+            check("pool:maxRuns", maxRuns, 1, 1);
+            check("pool:concurrency", probe.peak.load(), 1, 4);
+        }
+
+        pool.run({}, [](int, size_t) {});
+        check("pool:emptyBatch", 1, 1, 1);
+    }
+
+    // Skewed work: long jobs all dealt to worker 0 get stolen by the others
+    {
+        WorkStealingPool pool(4);
+        std::vector<size_t> order;
+        for (size_t i = 0; i < 16; ++i) order.push_back(i);
+
+        std::vector<std::atomic<int>> ranOn(4);
+        pool.run(order, [&](int worker, size_t job) {
+            ranOn[worker].fetch_add(1);
+            // Jobs dealt to worker 0 (0, 4, 8, 12) are slow
+            auto delay = job % 4 == 0 ? std::chrono::milliseconds(40) : std::chrono::milliseconds(1);
+            std::this_thread::sleep_for(delay);
+        });
+        int busiest = 0;
+        for (auto& count : ranOn) busiest = std::max(busiest, count.load());
+        check("steal:steals", static_cast<double>(pool.getStealCount()), 1, 16);
+        check("steal:balanced", busiest, 1, 12);
+    }
+
+    // I/O gate: never more than N inside the guarded region
+    {
+        const int limit = 2;
+        IOGate gate(limit);
+        ConcurrencyProbe probe;
+        WorkStealingPool pool(8);
+        std::vector<size_t> order(64);
+        std::iota(order.begin(), order.end(), 0);
+
+        pool.run(order, [&](int, size_t) {
+            IOGate::Scope permit(&gate);
+            probe.enter();
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+            probe.leave();
+        });
+        check("gate:peak", probe.peak.load(), 1, limit);
+
+        // Null gate is a no-op
+        IOGate::Scope unlimited(nullptr);
+        check("gate:null", 1, 1, 1);
+    }
+
+    return testSummary();
+}
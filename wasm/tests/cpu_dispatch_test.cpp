@@ -0,0 +1,142 @@
+/*
+ * Runtime CPU dispatch test
+ * Every kernel variant this CPU can run must reproduce the baseline table
+ * bit for bit (dB conversions, flat-TPDF quantiser, FIR up/downsampling
+ * at 2x/4x/8x), and a limiter built under each variant must render the
+ * same output.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "CpuDispatch.h"
+#include "TestCheck.h"
+#include "TruePeakLimiter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename Sample>
+static int countMismatches(const std::vector<Sample>& a, const std::vector<Sample>& b) {
+    int mismatches = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) mismatches++;
+    }
+    return mismatches;
+}
+
+// Odd length so every variant runs its vector body and its scalar tail
+static const int POINTS = 4099;
+
+template <typename Sample, typename Kernel>
+static int compareGain(Kernel baseline, Kernel variant, double minValue, double maxValue, bool logSpaced) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(minValue, maxValue);
+    std::vector<Sample> input(POINTS), expected(POINTS), actual(POINTS);
+    for (auto& x : input) {
+        double v = dist(rng);
+        x = static_cast<Sample>(logSpaced ? std::pow(10.0, v / 20.0) : v);
+    }
+    input[0] = 0;  // Below the silence floor
+    baseline(input.data(), expected.data(), POINTS);
+    variant(input.data(), actual.data(), POINTS);
+    return countMismatches(expected, actual);
+}
+
+static int compareDither(const DSPKernelTable& base, const DSPKernelTable& table) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> signal(-1.0, 1.0), noise(-1.0, 1.0);
+    std::vector<double> expected(POINTS), actual(POINTS), tpdf(POINTS);
+    for (int i = 0; i < POINTS; ++i) {
+        expected[i] = actual[i] = signal(rng);
+        tpdf[i] = noise(rng);
+    }
+    const double scale = 32767.0, lsb = 1.0 / 32767.0;
+    base.ditherQuantizeF64(expected.data(), tpdf.data(), POINTS, scale, lsb);
+    table.ditherQuantizeF64(actual.data(), tpdf.data(), POINTS, scale, lsb);
+    return countMismatches(expected, actual);
+}
+
+static int compareFIR(const DSPKernelTable& base, const DSPKernelTable& table, int index) {
+    const int factor = 2 << index;
+    const int tapCount = 16 * factor;
+    std::mt19937 rng(13 + index);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> history(2 * tapCount), taps(2 * tapCount);
+    for (auto& x : history) x = dist(rng);
+    for (int j = 0; j < tapCount; ++j) taps[2 * j] = taps[2 * j + 1] = dist(rng);  // One copy per lane
+
+    std::vector<double> expected(2 * factor + 2), actual(2 * factor + 2);
+    base.firUpsampleF64[index](history.data(), taps.data(), expected.data());
+    table.firUpsampleF64[index](history.data(), taps.data(), actual.data());
+    base.firDownsampleF64[index](history.data(), taps.data(), expected.data() + 2 * factor);
+    table.firDownsampleF64[index](history.data(), taps.data(), actual.data() + 2 * factor);
+    return countMismatches(expected, actual);
+}
+
+template <typename Quality>
+static std::vector<double> renderLimiter() {
+    auto limiter = std::make_unique<TruePeakLimiter<double, Quality>>();
+    limiter->setSampleRate(48000.0);
+    limiter->setThreshold(-6.0);
+    std::vector<double> output;
+    for (int i = 0; i < 8192; ++i) {
+        double x = 1.5 * std::sin(6.283185307179586 * 997.0 * i / 48000.0);
+        double left = x, right = -0.7 * x;
+        limiter->processStereo(left, right);
+        output.push_back(left);
+        output.push_back(right);
+    }
+    return output;
+}
+
+static void checkVariant(CpuIsa isa) {
+    const DSPKernelTable& base = *dspKernelVariant(CPU_ISA_BASELINE);
+    const DSPKernelTable* table = dspKernelVariant(isa);
+    if (!table) {
+        std::printf("  %-9s not supported on this CPU, skipped\n", cpuIsaName(isa));
+        return;
+    }
+    std::printf("  %s\n", table->name);
+    std::string name = table->name;
+
+    check((name + " linearToDbF64:mismatches").c_str(),
+          compareGain<double>(base.linearToDbF64, table->linearToDbF64, -140.0, 24.0, true), 0, 0);
+    check((name + " linearToDbF32:mismatches").c_str(),
+          compareGain<float>(base.linearToDbF32, table->linearToDbF32, -140.0, 24.0, true), 0, 0);
+    check((name + " dbToLinearF64:mismatches").c_str(),
+          compareGain<double>(base.dbToLinearF64, table->dbToLinearF64, -7000.0, 7000.0, false), 0, 0);
+    check((name + " dbToLinearF32:mismatches").c_str(),
+          compareGain<float>(base.dbToLinearF32, table->dbToLinearF32, -900.0, 900.0, false), 0, 0);
+    check((name + " ditherQuantize:mismatches").c_str(), compareDither(base, *table), 0, 0);
+    for (int index = 0; index < 3; ++index) {
+        std::string label = name + " fir" + std::to_string(2 << index) + "x:mismatches";
+        check(label.c_str(), compareFIR(base, *table, index), 0, 0);
+    }
+
+    // Oversamplers pick their kernels at construction
+    selectDSPKernels(CPU_ISA_BASELINE);
+    auto expected = renderLimiter<StandardQuality>();
+    selectDSPKernels(isa);
+    auto actual = renderLimiter<StandardQuality>();
+    check((name + " limiter:mismatches").c_str(), countMismatches(expected, actual), 0, 0);
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("Runtime CPU dispatch (detected: %s, active: %s)\n",
+                cpuIsaName(detectCpuIsa()), dspKernels().name);
+    std::printf("========================================\n");
+
+    check("baseline:available", dspKernelVariant(CPU_ISA_BASELINE) != nullptr ? 1.0 : 0.0, 1.0, 1.0);
+    check("detected:available", dspKernelVariant(detectCpuIsa()) != nullptr ? 1.0 : 0.0, 1.0, 1.0);
+
+    for (int isa = CPU_ISA_AVX2; isa < CPU_ISA_COUNT; ++isa) {
+        checkVariant(static_cast<CpuIsa>(isa));
+    }
+
+    return testSummary();
+}
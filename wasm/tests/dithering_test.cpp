@@ -0,0 +1,110 @@
+/*
+ * Dithering test
+ * Left and right streams must be uncorrelated, flat TPDF must add the
+ * textbook 0.5 LSB rms of error, and the shaped modes must move the error
+ * spectrum: F-weighted pushes it from the 4 kHz region up towards Nyquist,
+ * high-pass tilts it 6 dB/octave.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "Dithering.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int BLOCK = 1024;
+constexpr int BLOCKS = 64;
+constexpr double LSB = 1.0 / 32768.0;
+
+// A quiet sine that spans many quantiser steps, so the error is signal-independent
+static double input(int n) {
+    return 0.1 * std::sin(2.0 * M_PI * 997.0 * n / SAMPLE_RATE);
+}
+
+// Goertzel power of one bin
+static double binPower(const double* x, int count, double frequency) {
+    const double coeff = 2.0 * std::cos(2.0 * M_PI * frequency / SAMPLE_RATE);
+    double s1 = 0.0, s2 = 0.0;
+    for (int i = 0; i < count; ++i) {
+        double s0 = x[i] + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    return s1 * s1 + s2 * s2 - coeff * s1 * s2;
+}
+
+// Error power at two frequencies (dB difference high - low), averaged over blocks
+static double spectralTilt(NoiseShaping mode, double lowHz, double highHz) {
+    Dithering<double> dither;
+    dither.setEnabled(true);
+    dither.setTargetBits(16);
+    dither.setNoiseShaping(mode);
+
+    std::vector<double> block(BLOCK), error(BLOCK);
+    double low = 0.0, high = 0.0;
+    for (int b = 0; b < BLOCKS; ++b) {
+        for (int i = 0; i < BLOCK; ++i) block[i] = input(b * BLOCK + i);
+        dither.processBlock(block.data(), BLOCK);
+        for (int i = 0; i < BLOCK; ++i) error[i] = block[i] - input(b * BLOCK + i);
+        low += binPower(error.data(), BLOCK, lowHz);
+        high += binPower(error.data(), BLOCK, highHz);
+    }
+    return 10.0 * std::log10(high / low);
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("Dithering\n");
+    std::printf("========================================\n");
+
+    // Flat TPDF: error rms 0.5 LSB, channels uncorrelated, outputs on the grid
+    {
+        Dithering<double> left(0), right(1);
+        for (auto* d : {&left, &right}) {
+            d->setEnabled(true);
+            d->setTargetBits(16);
+        }
+        const int count = BLOCK * BLOCKS;
+        double sumL = 0.0, sumR = 0.0, sumLL = 0.0, sumRR = 0.0, sumLR = 0.0;
+        int offGrid = 0;
+        for (int n = 0; n < count; ++n) {
+            double l = left.process(input(n));
+            double r = right.process(input(n));
+            offGrid += std::abs(l / LSB - std::round(l / LSB)) > 1e-9;
+            double el = (l - input(n)) / LSB, er = (r - input(n)) / LSB;
+            sumL += el; sumR += er;
+            sumLL += el * el; sumRR += er * er; sumLR += el * er;
+        }
+        double meanL = sumL / count, meanR = sumR / count;
+        double varL = sumLL / count - meanL * meanL, varR = sumRR / count - meanR * meanR;
+        double correlation = (sumLR / count - meanL * meanR) / std::sqrt(varL * varR);
+        check("flat:errorRmsLSB", std::sqrt(sumLL / count), 0.49, 0.51);
+        check("flat:offGrid", offGrid, 0, 0);
+        check("stereo:correlation", std::abs(correlation), 0.0, 0.02);
+    }
+
+    // Reset reproduces the same stream
+    {
+        Dithering<double> dither(3);
+        dither.setEnabled(true);
+        double first = dither.process(input(5));
+        for (int n = 0; n < 1000; ++n) dither.process(input(n));
+        dither.reset();
+        check("reset:repeatable", dither.process(input(5)) - first, 0.0, 0.0);
+    }
+
+    // F-weighted: deep notch around 4 kHz, boosted near Nyquist
+    check("fWeighted:20k-4kDB", spectralTilt(NOISE_SHAPING_F_WEIGHTED, 4000.0, 20000.0), 30.0, 70.0);
+
+    // High-pass 1 - z^-1: |2 sin(pi f / fs)|, 20 log10(sin(75 deg) / sin(15 deg)) = 11.4 dB
+    check("highPass:18k-3kDB", spectralTilt(NOISE_SHAPING_HIGH_PASS, 3000.0, 18000.0), 9.0, 14.0);
+
+    // Flat stays flat
+    check("flat:18k-3kDB", spectralTilt(NOISE_SHAPING_FLAT, 3000.0, 18000.0), -2.0, 2.0);
+
+    return testSummary();
+}
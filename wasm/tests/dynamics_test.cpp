@@ -0,0 +1,85 @@
+/*
+ * Multiband compressor test
+ * DC passes the low LR4 band untouched and nothing else, so a steady DC
+ * input reads the low band's static curve directly: threshold and ratio
+ * above the knee, the quadratic knee at the threshold. A loud left and a
+ * quiet right channel then show the difference between the stereo-linked
+ * and independent detectors.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "Dynamics.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+constexpr double SAMPLE_RATE = 48000.0;
+
+// Two seconds of DC through the compressor; the settled output in dB
+static void renderDC(MultibandCompressor<double>& compressor, double leftDB, double rightDB,
+                     double& outLeftDB, double& outRightDB) {
+    const int frames = static_cast<int>(SAMPLE_RATE * 2);
+    std::vector<double> left(frames, dbToLinear(leftDB)), right(frames, dbToLinear(rightDB));
+    for (int offset = 0; offset < frames; offset += 512) {
+        compressor.processBlock(left.data() + offset, right.data() + offset, std::min(512, frames - offset));
+    }
+    outLeftDB = linearToDb(left.back());
+    outRightDB = linearToDb(right.back());
+}
+
+static void configure(MultibandCompressor<double>& compressor, double kneeDB) {
+    compressor.setSampleRate(SAMPLE_RATE);
+    compressor.setEnabled(true);
+    compressor.setLowBand(-20.0, 4.0);
+    compressor.setBandKnee(0, kneeDB);
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("Multiband compressor\n");
+    std::printf("========================================\n");
+
+    double left, right;
+
+    // 10 dB over a -20 dB / 4:1 threshold: 7.5 dB of gain reduction
+    {
+        MultibandCompressor<double> compressor;
+        configure(compressor, 0.0);
+        renderDC(compressor, -10.0, -10.0, left, right);
+        check("curve:hardKnee", left, -17.55, -17.45);
+    }
+
+    // At the threshold a 6 dB knee gives (1/4 - 1) * 3^2 / 12 = -0.5625 dB
+    {
+        MultibandCompressor<double> compressor;
+        configure(compressor, 6.0);
+        renderDC(compressor, -20.0, -20.0, left, right);
+        check("curve:kneeAtThreshold", left, -20.6125, -20.5125);
+        renderDC(compressor, -30.0, -30.0, left, right);
+        check("curve:belowKnee", left, -30.01, -29.99);
+    }
+
+    // Linked: the quiet channel follows the loud one's gain reduction
+    {
+        MultibandCompressor<double> compressor;
+        configure(compressor, 0.0);
+        renderDC(compressor, -10.0, -40.0, left, right);
+        check("link:loud", left, -17.55, -17.45);
+        check("link:quietFollows", right, -47.55, -47.45);
+    }
+
+    // Independent: each channel has its own detector
+    {
+        MultibandCompressor<double> compressor;
+        configure(compressor, 0.0);
+        compressor.setStereoLink(false);
+        renderDC(compressor, -10.0, -40.0, left, right);
+        check("independent:loud", left, -17.55, -17.45);
+        check("independent:quietUntouched", right, -40.01, -39.99);
+    }
+
+    return testSummary();
+}
@@ -0,0 +1,58 @@
+/*
+ * FastMath dB conversion test
+ * fastLinearToDb / fastDbToLinear must stay within 0.001 dB of libm over
+ * -120..+24 dB in both precisions, the block kernels must match the scalar
+ * calls bit for bit, and the 1e-10 floor and range clamps must hold.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "DSPCommon.h"
+#include "FastMath.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+template <typename Sample>
+static void checkPrecision(const std::string& name) {
+    const int points = 200000;
+    std::vector<Sample> gains(points), levels(points), toDb(points), toLinear(points);
+    for (int i = 0; i < points; ++i) {
+        gains[i] = static_cast<Sample>(-120.0 + 144.0 * i / (points - 1));
+        levels[i] = static_cast<Sample>(std::pow(10.0, gains[i] / 20.0));
+    }
+    linearToDbBlock(levels.data(), toDb.data(), points);
+    dbToLinearBlock(gains.data(), toLinear.data(), points);
+
+    double toDbError = 0.0, toLinearError = 0.0;
+    int mismatches = 0;
+    for (int i = 0; i < points; ++i) {
+        toDbError = std::max(toDbError, std::abs(toDb[i] - 20.0 * std::log10(static_cast<double>(levels[i]))));
+        toLinearError = std::max(toLinearError, std::abs(20.0 * std::log10(static_cast<double>(toLinear[i])) - gains[i]));
+        if (toDb[i] != fastLinearToDb(levels[i]) || toLinear[i] != fastDbToLinear(gains[i])) mismatches++;
+    }
+    check((name + " linearToDb:errorDB").c_str(), toDbError, 0.0, 0.001);
+    check((name + " dbToLinear:errorDB").c_str(), toLinearError, 0.0, 0.001);
+    check((name + " block:mismatches").c_str(), mismatches, 0, 0);
+
+    // Exact powers of two, silence and out-of-range gains
+    check((name + " log2:exact").c_str(), fastLog2(Sample(0.25)), -2.0, -2.0);
+    check((name + " exp2:exact").c_str(), fastExp2(Sample(3)), 8.0, 8.0);
+    check((name + " linearToDb:silence").c_str(), fastLinearToDb(Sample(0)), -200.001, -199.999);
+    check((name + " dbToLinear:finite").c_str(), std::isfinite(fastDbToLinear(Sample(1e6))) ? 1.0 : 0.0, 1.0, 1.0);
+    check((name + " dbToLinear:floor").c_str(), fastDbToLinear(Sample(-1e6)), 0.0, 1e-30);
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("FastMath dB conversions\n");
+    std::printf("========================================\n");
+
+    checkPrecision<double>("double");
+    checkPrecision<float>("float");
+
+    return testSummary();
+}
@@ -0,0 +1,165 @@
+/*
+ * LoudnessHistogram validation harness
+ * Compares histogram-gated integrated loudness and loudness range against
+ * the exact BS.1770-4 / EBU Tech 3342 computations over every stored block.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "LoudnessHistogram.h"
+#include "TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Exact reference gating: absolute gate, then mean + relativeGateLU
+static std::vector<double> exactGate(const std::vector<double>& blocks, double relativeGateLU) {
+    std::vector<double> gated;
+    for (double ms : blocks) {
+        if (LoudnessHistogram::energyToLUFS(ms) > LoudnessHistogram::ABSOLUTE_GATE) gated.push_back(ms);
+    }
+    if (gated.empty()) return gated;
+
+    double mean = 0.0;
+    for (double ms : gated) mean += ms;
+    mean /= gated.size();
+    double relativeGate = LoudnessHistogram::energyToLUFS(mean) + relativeGateLU;
+
+    std::vector<double> result;
+    for (double ms : gated) {
+        if (LoudnessHistogram::energyToLUFS(ms) > relativeGate) result.push_back(ms);
+    }
+    return result;
+}
+
+// Exact BS.1770-4 integrated loudness: keeps every block, averages energies
+static double exactIntegratedLUFS(const std::vector<double>& blocks) {
+    std::vector<double> gated = exactGate(blocks, -10.0);
+    if (gated.empty()) return LoudnessHistogram::ABSOLUTE_GATE;
+
+    double sum = 0.0;
+    for (double ms : gated) sum += ms;
+    return LoudnessHistogram::energyToLUFS(sum / gated.size());
+}
+
+// Exact EBU Tech 3342 loudness range: sorts every gated short-term block
+static double exactLRA(const std::vector<double>& blocks) {
+    std::vector<double> gated = exactGate(blocks, -20.0);
+    if (gated.size() < 2) return 0.0;
+
+    std::vector<double> lufs;
+    for (double ms : gated) lufs.push_back(LoudnessHistogram::energyToLUFS(ms));
+    std::sort(lufs.begin(), lufs.end());
+    size_t low = static_cast<size_t>(0.10 * (lufs.size() - 1));
+    size_t high = static_cast<size_t>(0.95 * (lufs.size() - 1));
+    return lufs[high] - lufs[low];
+}
+
+// Mean-square blocks of `length` sub-blocks taken every `hop` sub-blocks
+static std::vector<double> makeBlocks(const std::vector<double>& subBlocks, size_t length, size_t hop) {
+    std::vector<double> blocks;
+    for (size_t end = length; end <= subBlocks.size(); end += hop) {
+        double sum = 0.0;
+        for (size_t i = end - length; i < end; ++i) sum += subBlocks[i];
+        blocks.push_back(sum / length);
+    }
+    return blocks;
+}
+
+// Synthetic programme as 100ms sub-block energies: sections of different
+// levels with fluctuation, fades and silent gaps
+static std::vector<double> makeProgramme(unsigned seed, int minutes) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> sectionLevel(-40.0, -6.0);
+    std::uniform_int_distribution<int> sectionLength(20, 600);
+    std::normal_distribution<double> jitter(0.0, 2.5);
+    std::bernoulli_distribution silence(0.1);
+
+    std::vector<double> subBlocks;
+    const size_t total = static_cast<size_t>(minutes) * 600;
+    while (subBlocks.size() < total) {
+        double level = silence(rng) ? -90.0 : sectionLevel(rng);
+        int length = sectionLength(rng);
+        for (int i = 0; i < length; ++i) {
+            double fade = (i < 10) ? (10 - i) * -3.0 : 0.0;
+            subBlocks.push_back(LoudnessHistogram::lufsToEnergy(level + fade + jitter(rng)));
+        }
+    }
+    return subBlocks;
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("LoudnessHistogram vs exact BS.1770-4 gating\n");
+    std::printf("========================================\n");
+
+    // Dynamic programmes of increasing length
+    const int lengths[] = {1, 5, 30, 90};
+    unsigned seed = 1;
+    for (int minutes : lengths) {
+        for (int run = 0; run < 5; ++run, ++seed) {
+            // 400ms gating blocks at a 100ms hop
+            std::vector<double> blocks = makeBlocks(makeProgramme(seed, minutes), 4, 1);
+            LoudnessHistogram histogram;
+            for (double ms : blocks) histogram.addBlock(ms);
+
+            double exact = exactIntegratedLUFS(blocks);
+            double fast = histogram.gatedLoudness(-10.0);
+            char label[64];
+            std::snprintf(label, sizeof(label), "integrated:%dmin:seed%u", minutes, seed);
+            check(label, fast - exact, -0.05, 0.05);
+            if (run == 0) {
+                std::printf("  %3d min: exact %.3f LUFS, histogram %.3f LUFS (delta %+.4f LU)\n",
+                            minutes, exact, fast, fast - exact);
+            }
+        }
+    }
+
+    // Loudness range: 3s short-term blocks at a 1s hop, 10th-95th percentile
+    seed = 100;
+    for (int minutes : lengths) {
+        for (int run = 0; run < 5; ++run, ++seed) {
+            std::vector<double> blocks = makeBlocks(makeProgramme(seed, minutes), 30, 10);
+            LoudnessHistogram histogram;
+            for (double ms : blocks) histogram.addBlock(ms);
+
+            double exact = exactLRA(blocks);
+            double fast = histogram.percentile(0.95, -20.0) - histogram.percentile(0.10, -20.0);
+            char label[64];
+            std::snprintf(label, sizeof(label), "lra:%dmin:seed%u", minutes, seed);
+            check(label, fast - exact, -0.1, 0.1);
+            if (run == 0) {
+                std::printf("  %3d min: exact LRA %.2f LU, histogram %.2f LU (delta %+.3f LU)\n",
+                            minutes, exact, fast, fast - exact);
+            }
+        }
+    }
+
+    // Steady tone at a known level
+    {
+        LoudnessHistogram histogram;
+        for (int i = 0; i < 1000; ++i) histogram.addBlock(LoudnessHistogram::lufsToEnergy(-23.0));
+        check("steady:-23LUFS", histogram.gatedLoudness(-10.0), -23.0001, -22.9999);
+    }
+
+    // Silence only: everything below the absolute gate
+    {
+        LoudnessHistogram histogram;
+        for (int i = 0; i < 1000; ++i) histogram.addBlock(1e-12);
+        check("silence:blocks", static_cast<double>(histogram.getBlockCount()), 0.0, 0.0);
+        check("silence:integrated", histogram.gatedLoudness(-10.0), -70.0, -70.0);
+    }
+
+    // Reset clears all state
+    {
+        LoudnessHistogram histogram;
+        histogram.addBlock(LoudnessHistogram::lufsToEnergy(-10.0));
+        histogram.reset();
+        check("reset:blocks", static_cast<double>(histogram.getBlockCount()), 0.0, 0.0);
+    }
+
+    return testSummary();
+}
@@ -0,0 +1,119 @@
+/*
+ * luvlang-master support test
+ * Streaming WAV round trips, preset JSON parsing and platform defaults.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "MasteringPreset.h"
+#include "TestCheck.h"
+#include "WavFile.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static bool throws(const std::string& json) {
+    try {
+        PresetJSONParser(json).parse();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("luvlang-master WAV I/O and presets\n");
+    std::printf("========================================\n");
+
+    const std::string path = "luvlang_master_test.wav";
+    const int frames = 10000;
+    std::vector<float> left(frames), right(frames);
+    for (int i = 0; i < frames; ++i) {
+        left[i] = static_cast<float>(0.8 * std::sin(2.0 * PI * 440.0 * i / 48000.0));
+        right[i] = static_cast<float>(-0.5 * std::sin(2.0 * PI * 220.0 * i / 48000.0));
+    }
+
+    // Round trip per output format, read back in odd-sized blocks
+    const WavWriter::SampleFormat formats[] = {WavWriter::PCM_16, WavWriter::PCM_24, WavWriter::FLOAT_32};
+    const char* names[] = {"pcm16", "pcm24", "float32"};
+    const double tolerances[] = {1.0 / 32768.0, 1.0 / 8388608.0, 0.0};
+    for (int f = 0; f < 3; ++f) {
+        {
+            WavWriter writer(path, 48000, formats[f]);
+            writer.write(left.data(), right.data(), 3000);
+            writer.write(left.data() + 3000, right.data() + 3000, frames - 3000);
+            writer.close();
+        }
+
+        WavReader reader(path);
+        std::vector<float> l(777), r(777);
+        double maxError = 0.0;
+        int position = 0;
+        size_t got;
+        while ((got = reader.read(l.data(), r.data(), l.size())) > 0) {
+            for (size_t i = 0; i < got; ++i, ++position) {
+                maxError = std::max(maxError, static_cast<double>(std::abs(l[i] - left[position])));
+                maxError = std::max(maxError, static_cast<double>(std::abs(r[i] - right[position])));
+            }
+        }
+        std::string label = std::string("wav:") + names[f];
+        check((label + ":frames").c_str(), position, frames, frames);
+        check((label + ":rate").c_str(), reader.getSampleRate(), 48000, 48000);
+        check((label + ":error").c_str(), maxError, 0.0, tolerances[f]);
+
+        reader.rewind();
+        check((label + ":rewind").c_str(), static_cast<double>(reader.read(l.data(), r.data(), 10)), 10, 10);
+        check((label + ":rewindSample").c_str(), l[5] - left[5], -tolerances[f], tolerances[f]);
+    }
+    std::remove(path.c_str());
+
+    // Preset JSON
+    {
+        UserParams params = PresetJSONParser(
+            "{ \"platform\": \"apple\", \"bass\": -1.5, \"width\": 110,\n"
+            "  \"air\": true, \"notes\": null, \"eq\": [0, 1.5, 0, 0, 0, -2, 0] }").parse();
+        check("json:bass", params.get("bass", 0.0), -1.5, -1.5);
+        check("json:width", params.get("width", 0.0), 110.0, 110.0);
+        check("json:bool", params.get("air", 0.0), 1.0, 1.0);
+        check("json:null", params.has("notes") ? 1.0 : 0.0, 0.0, 0.0);
+        check("json:eq[5]", params.get("eq[5]", 0.0), -2.0, -2.0);
+        check("json:platform", params.strings["platform"] == "apple" ? 1.0 : 0.0, 1.0, 1.0);
+
+        check("json:nested", throws("{\"a\": {\"b\": 1}}") ? 1.0 : 0.0, 1.0, 1.0);
+        check("json:trailing", throws("{\"a\": 1} x") ? 1.0 : 0.0, 1.0, 1.0);
+        check("json:unterminated", throws("{\"a\": \"b") ? 1.0 : 0.0, 1.0, 1.0);
+    }
+
+    // Platform defaults (master_audio_ultimate.py) and user overrides
+    {
+        UserParams none;
+        PlatformPreset apple = getPlatformPreset("apple", none);
+        check("platform:apple:lufs", apple.targetLUFS, -16.0, -16.0);
+        check("platform:apple:ratio", apple.compressionRatio, 3.0, 3.0);
+        check("platform:apple:saturation", apple.saturation, 0.15, 0.15);
+
+        PlatformPreset radio = getPlatformPreset("radio", none);
+        check("platform:radio:truePeak", radio.truePeak, -0.3, -0.3);
+        check("platform:radio:width", radio.stereoWidth, 0.9, 0.9);
+
+        UserParams user;
+        user.numbers["loudness"] = -12.0;
+        user.numbers["compression"] = 10.0;
+        PlatformPreset spotify = getPlatformPreset("spotify", user);
+        check("platform:override:lufs", spotify.targetLUFS, -12.0, -12.0);
+        check("platform:override:ratio", spotify.compressionRatio, 10.0, 10.0);
+
+        bool unknown = false;
+        try {
+            getPlatformPreset("myspace", none);
+        } catch (const std::runtime_error&) {
+            unknown = true;
+        }
+        check("platform:unknown", unknown ? 1.0 : 0.0, 1.0, 1.0);
+    }
+
+    return testSummary();
+}
@@ -0,0 +1,251 @@
+/*
+ * MasteringEngine native smoke test
+ * Renders the full chain through libluvlang_dsp.a (no Emscripten) and checks
+ * output sanity, metering, the parameter queue, the streaming rings, the
+ * block pipeline against the per-sample reference, the float32 chain
+ * against the double one, the limiter look-ahead as a pure delay that
+ * getLatencySamples() tracks across rates, and K-weighting after a rate
+ * change.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "MasteringEngine.h"
+#include "TestCheck.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int BLOCK = 512;
+
+// 110 Hz + 3.5 kHz, loud enough to drive the limiter
+static void fillProgramme(std::vector<float>& left, std::vector<float>& right, int frames, double amplitude) {
+    left.resize(frames);
+    right.resize(frames);
+    for (int i = 0; i < frames; ++i) {
+        double t = i / SAMPLE_RATE;
+        left[i] = static_cast<float>(amplitude * (0.7 * std::sin(2.0 * PI * 110.0 * t) + 0.3 * std::sin(2.0 * PI * 3500.0 * t)));
+        right[i] = static_cast<float>(amplitude * (0.7 * std::sin(2.0 * PI * 110.0 * t + 0.2) + 0.3 * std::sin(2.0 * PI * 3500.0 * t)));
+    }
+}
+
+template <typename Engine>
+static double renderPeak(Engine& engine, std::vector<float>& left, std::vector<float>& right, int skip) {
+    double peak = 0.0;
+    for (size_t offset = 0; offset + BLOCK <= left.size(); offset += BLOCK) {
+        engine.processPlanar(left.data() + offset, right.data() + offset, BLOCK);
+        if (static_cast<int>(offset) < skip) continue;
+        for (int i = 0; i < BLOCK; ++i) {
+            peak = std::max(peak, static_cast<double>(std::abs(left[offset + i])));
+            peak = std::max(peak, static_cast<double>(std::abs(right[offset + i])));
+        }
+    }
+    return peak;
+}
+
+// Every stage active, AI on, so the AI re-tune at each correlation window
+// is exercised too
+template <typename Engine>
+static void enableFullChain(Engine& engine) {
+    engine.setInputGain(3.0);
+    engine.setAllEQGains({2.0, -1.0, 0.5, 0.0, 1.5, -2.0, 3.0});
+    engine.setDeEsserEnabled(true);
+    engine.setDeEsserThreshold(-30.0);
+    engine.setMultibandEnabled(true);
+    engine.setStereoWidth(1.4);
+    engine.setSaturationDrive(2.0);
+    engine.setSaturationMix(0.3);
+    engine.setLimiterThreshold(-1.0);
+    engine.setDitheringEnabled(true);
+    engine.setDitheringBits(16);
+    engine.setAIEnabled(true);
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("MasteringEngine native smoke test\n");
+    std::printf("========================================\n");
+
+    std::vector<float> left, right;
+
+    // Full chain on a hot programme: finite output under the ceiling, meters move
+    {
+        MasteringEngine engine(SAMPLE_RATE);
+        engine.setLimiterThreshold(-1.0);
+        fillProgramme(left, right, static_cast<int>(SAMPLE_RATE * 10), 0.9);
+        double peak = renderPeak(engine, left, right, static_cast<int>(SAMPLE_RATE));
+
+        bool finite = true;
+        for (size_t i = 0; i < left.size(); ++i) {
+            finite = finite && std::isfinite(left[i]) && std::isfinite(right[i]);
+        }
+        check("chain:finite", finite ? 1.0 : 0.0, 1.0, 1.0);
+        check("chain:peakDB", linearToDb(peak), -60.0, 0.0);
+        check("chain:integratedLUFS", engine.getIntegratedLUFS(), -30.0, 0.0);
+        check("chain:shortTermLUFS", engine.getShortTermLUFS(), -30.0, 0.0);
+        check("chain:phaseCorrelation", engine.getPhaseCorrelation(), 0.5, 1.0);
+
+        MeterSnapshot snapshot;
+        check("snapshot:read", engine.readMeterSnapshot(snapshot) ? 1.0 : 0.0, 1.0, 1.0);
+        check("snapshot:integrated", snapshot.integratedLUFS, -30.0, 0.0);
+
+        MixHealthReport health = engine.getMixHealthReport();
+        check("health:integrated", health.integratedLUFS, -30.0, 0.0);
+    }
+
+    // Queued parameter changes land at the next block boundary
+    {
+        MasteringEngine quiet(SAMPLE_RATE);
+        MasteringEngine trimmed(SAMPLE_RATE);
+        check("queue:push", trimmed.pushParameter(PARAM_INPUT_GAIN, 0, -12.0) ? 1.0 : 0.0, 1.0, 1.0);
+
+        std::vector<float> l2, r2;
+        fillProgramme(left, right, static_cast<int>(SAMPLE_RATE * 5), 0.1);
+        fillProgramme(l2, r2, static_cast<int>(SAMPLE_RATE * 5), 0.1);
+        renderPeak(quiet, left, right, 0);
+        renderPeak(trimmed, l2, r2, 0);
+        check("queue:inputGainDelta", trimmed.getShortTermLUFS() - quiet.getShortTermLUFS(), -12.5, -11.5);
+    }
+
+    // Streaming: 128-frame quanta through the rings, no underruns after priming
+    {
+        MasteringEngine engine(SAMPLE_RATE);
+        engine.resetStream(128);
+        AudioRingBuffer* input = reinterpret_cast<AudioRingBuffer*>(engine.getInputRingPtr());
+        AudioRingBuffer* output = reinterpret_cast<AudioRingBuffer*>(engine.getOutputRingPtr());
+
+        fillProgramme(left, right, 128, 0.2);
+        std::vector<float> outL(128), outR(128);
+        int underruns = 0;
+        for (int quantum = 0; quantum < 2000; ++quantum) {
+            input->write(left.data(), right.data(), 128);
+            engine.processQueued();
+            if (output->read(outL.data(), outR.data(), 128) < 128) underruns++;
+        }
+        check("stream:underruns", underruns, 0, 0);
+        check("stream:latency", engine.getStreamLatencySamples(), 384, 384);
+    }
+
+    // Block pipeline == per-sample processStereo(), bit for bit, across odd
+    // block sizes that straddle correlation windows
+    {
+        MasteringEngine blockEngine(SAMPLE_RATE);
+        MasteringEngine sampleEngine(SAMPLE_RATE);
+        enableFullChain(blockEngine);
+        enableFullChain(sampleEngine);
+
+        const int frames = static_cast<int>(SAMPLE_RATE * 3);
+        fillProgramme(left, right, frames, 0.8);
+        std::vector<float> refL = left, refR = right;
+
+        const int blockSizes[] = {1, 7, 128, 333, 4096, 1000, 4095};
+        int offset = 0;
+        for (int n = 0; offset < frames; ++n) {
+            int count = std::min(blockSizes[n % 7], frames - offset);
+            blockEngine.processPlanar(left.data() + offset, right.data() + offset, count);
+            for (int i = offset; i < offset + count; ++i) {
+                double l = refL[i], r = refR[i];
+                sampleEngine.processStereo(l, r);
+                refL[i] = static_cast<float>(l);
+                refR[i] = static_cast<float>(r);
+            }
+            offset += count;
+        }
+
+        int mismatches = 0;
+        for (int i = 0; i < frames; ++i) {
+            if (left[i] != refL[i] || right[i] != refR[i]) mismatches++;
+        }
+        check("block:mismatches", mismatches, 0, 0);
+        check("block:integratedLUFS", blockEngine.getIntegratedLUFS() - sampleEngine.getIntegratedLUFS(), 0.0, 0.0);
+        check("block:truePeak", blockEngine.getTruePeakDB() - sampleEngine.getTruePeakDB(), 0.0, 0.0);
+        check("block:crest", blockEngine.getCrestFactor() - sampleEngine.getCrestFactor(), 0.0, 0.0);
+    }
+
+    // The float32 chain nulls against the double reference (dither off, so
+    // the residual is precision alone)
+    {
+        MasteringEngine reference(SAMPLE_RATE);
+        MasteringEngineF32 single(SAMPLE_RATE);
+        enableFullChain(reference);
+        enableFullChain(single);
+        reference.setDitheringEnabled(false);
+        single.setDitheringEnabled(false);
+
+        const int frames = static_cast<int>(SAMPLE_RATE * 3);
+        fillProgramme(left, right, frames, 0.8);
+        std::vector<float> singleL = left, singleR = right;
+        renderPeak(reference, left, right, 0);
+        renderPeak(single, singleL, singleR, 0);
+
+        double residual = 0.0;
+        for (int i = 0; i < frames; ++i) {
+            residual = std::max(residual, static_cast<double>(std::abs(singleL[i] - left[i])));
+            residual = std::max(residual, static_cast<double>(std::abs(singleR[i] - right[i])));
+        }
+        check("float:residualDB", linearToDb(std::max(residual, 1e-12)), -240.0, -80.0);
+        check("float:integratedLUFS", single.getIntegratedLUFS() - reference.getIntegratedLUFS(), -0.01, 0.01);
+    }
+
+    // The look-ahead is a pure delay: below the threshold, output with L
+    // frames of look-ahead is the zero-look-ahead output shifted by exactly
+    // L frames, and getLatencySamples() moves by L (rate changes included)
+    {
+        const double rates[] = {44100.0, 96000.0};
+        const double lookAheads[] = {5.0, 50.0};
+        int mismatches = 0;
+        for (double rate : rates) {
+            for (double lookAhead : lookAheads) {
+                MasteringEngine reference(48000.0), delayed(48000.0);
+                reference.setSampleRate(rate);
+                delayed.setSampleRate(rate);
+                reference.setLimiterLookAhead(0.0);
+                delayed.setLimiterLookAhead(lookAhead);
+                const int shift = static_cast<int>(std::lround(lookAhead * 0.001 * rate));
+                if (delayed.getLatencySamples() - reference.getLatencySamples() != shift) mismatches++;
+
+                std::vector<float> refL, refR, delL, delR;
+                fillProgramme(refL, refR, 16 * BLOCK, 0.3);
+                delL = refL;
+                delR = refR;
+                renderPeak(reference, refL, refR, 0);
+                renderPeak(delayed, delL, delR, 0);
+                for (size_t i = 0; i + shift < delL.size(); ++i) {
+                    if (delL[i + shift] != refL[i] || delR[i + shift] != refR[i]) mismatches++;
+                }
+            }
+        }
+        check("latency:lookAheadShiftMismatches", mismatches, 0, 0);
+        check("latency:zeroLookAhead", [] { MasteringEngine e(96000.0); e.setLimiterLookAhead(0.0); return e.getLatencySamples(); }(), 16, 16);
+    }
+
+    // K-weighting follows the sample rate: a 6 kHz tone (on the +4 dB shelf)
+    // reads the same loudness after a rate change as at 48 kHz
+    {
+        double lufs[2];
+        for (int r = 0; r < 2; ++r) {
+            double rate = r == 0 ? 48000.0 : 96000.0;
+            LUFSMeter meter(48000.0);
+            meter.setSampleRate(rate);
+            for (int i = 0; i < static_cast<int>(rate * 3); ++i) {
+                double x = 0.1 * std::sin(2.0 * PI * 6000.0 * i / rate);
+                meter.processSample(x, x);
+            }
+            lufs[r] = meter.getIntegratedLUFS();
+        }
+        check("lufs:rateIndependent", lufs[1] - lufs[0], -0.05, 0.05);
+    }
+
+    // Reset returns the meters to silence
+    {
+        MasteringEngine engine(SAMPLE_RATE);
+        fillProgramme(left, right, static_cast<int>(SAMPLE_RATE * 2), 0.5);
+        renderPeak(engine, left, right, 0);
+        engine.reset();
+        check("reset:integrated", engine.getIntegratedLUFS(), -70.0, -70.0);
+    }
+
+    return testSummary();
+}
@@ -0,0 +1,241 @@
+/*
+ * Polyphase oversampler and true-peak test
+ * For every quality tier, phase 0 of the interpolator must pass the input
+ * through with the documented delay, the other phases must recover inter-sample peaks, and
+ * an up/down round trip must be unity gain in the passband with
+ * LATENCY_SAMPLES of delay. The half-band IIR cascade must find the same
+ * peaks and report its (fractional) group delay exactly. The limiter's
+ * true-peak meter must see the inter-sample overs a sample-peak meter
+ * misses, with either filter, and its look-ahead must ramp the gain down
+ * before a transient reaches the output (sliding-window maximum checked
+ * against a brute-force scan), with getLatencySamples() exact at any rate
+ * and look-ahead time.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "TestCheck.h"
+#include "TruePeakLimiter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// fs/4 sine at 45 degrees: every sample sits at 0.7071, the peaks fall
+// exactly between samples. Then a 1 kHz round trip.
+template <typename Quality>
+static void checkTier() {
+    using Over = Oversampler<double, Quality::FACTOR, Quality::TAP_COUNT>;
+    using Pair = typename Over::Pair;
+    const int frames = 4800;
+    const int delay = Over::TAPS_PER_PHASE / 2;
+    const std::string tier = Quality::NAME;
+
+    {
+        Over oversampler;
+        typename Over::Frame up;
+        double passthroughError = 0.0, truePeak = 0.0, samplePeak = 0.0;
+        std::vector<double> input(frames);
+        for (int i = 0; i < frames; ++i) {
+            input[i] = std::sin(PI / 2.0 * i + PI / 4.0);
+        }
+        for (int i = 0; i < frames; ++i) {
+            oversampler.upsample(Pair(input[i], -input[i]), up);
+            if (i < delay + 64) continue;
+            passthroughError = std::max(passthroughError, std::abs(up[0].left() - input[i - delay]));
+            passthroughError = std::max(passthroughError, std::abs(up[0].right() + input[i - delay]));
+            samplePeak = std::max(samplePeak, std::abs(input[i]));
+            for (const Pair& frame : up) {
+                truePeak = std::max(truePeak, std::max(std::abs(frame.left()), std::abs(frame.right())));
+            }
+        }
+        check((tier + " up:phase0Passthrough").c_str(), passthroughError, 0.0, 1e-12);
+        check((tier + " up:samplePeakDB").c_str(), linearToDb(samplePeak), -3.02, -3.00);
+        check((tier + " up:truePeakDB").c_str(), linearToDb(truePeak), -0.1, 0.1);
+    }
+
+    // 1 kHz in, same 1 kHz out LATENCY_SAMPLES later
+    {
+        Over oversampler;
+        typename Over::Frame up;
+        const int latency = Over::LATENCY_SAMPLES;
+        std::vector<double> input(frames), output(frames);
+        for (int i = 0; i < frames; ++i) {
+            input[i] = 0.5 * std::sin(2.0 * PI * 1000.0 * i / 48000.0);
+            oversampler.upsample(Pair(input[i], input[i]), up);
+            output[i] = oversampler.downsample(up).left();
+        }
+        double error = 0.0;
+        for (int i = 256; i < frames; ++i) {
+            error = std::max(error, std::abs(output[i] - input[i - latency]));
+        }
+        check((tier + " roundTrip:errorDB").c_str(), linearToDb(error), -240.0, -60.0);
+    }
+}
+
+// Half-band cascade: same fs/4 peaks, impulse-response centroid equal to the
+// reported group delay, and a 1 kHz round trip delayed by that amount
+template <int Factor>
+static void checkHalfBand() {
+    using Over = HalfBandOversampler<double, Factor>;
+    using Pair = typename Over::Pair;
+    const int frames = 4800;
+    const std::string tier = "half-band " + std::to_string(Factor) + "x";
+
+    Over oversampler;
+    typename Over::Frame up;
+    double truePeak = 0.0;
+    for (int i = 0; i < frames; ++i) {
+        double x = std::sin(PI / 2.0 * i + PI / 4.0);
+        oversampler.upsample(Pair(x, -x), up);
+        if (i < 256) continue;
+        for (const Pair& frame : up) {
+            truePeak = std::max(truePeak, std::max(std::abs(frame.left()), std::abs(frame.right())));
+        }
+    }
+    check((tier + " up:truePeakDB").c_str(), linearToDb(truePeak), -0.1, 0.1);
+
+    oversampler.reset();
+    double sum = 0.0, moment = 0.0;
+    for (int i = 0; i < 512; ++i) {
+        oversampler.upsample(Pair(i == 0 ? 1.0 : 0.0, 0.0), up);
+        double y = oversampler.downsample(up).left();
+        sum += y;
+        moment += i * y;
+    }
+    check((tier + " impulse:dcGain").c_str(), sum, 1.0 - 1e-9, 1.0 + 1e-9);
+    check((tier + " impulse:groupDelayError").c_str(), moment / sum - oversampler.getGroupDelay(), -1e-6, 1e-6);
+
+    oversampler.reset();
+    const double delay = oversampler.getGroupDelay();
+    double error = 0.0;
+    for (int i = 0; i < frames; ++i) {
+        double x = 0.5 * std::sin(2.0 * PI * 1000.0 * i / 48000.0);
+        oversampler.upsample(Pair(x, x), up);
+        double y = oversampler.downsample(up).left();
+        if (i >= 256) {
+            error = std::max(error, std::abs(y - 0.5 * std::sin(2.0 * PI * 1000.0 * (i - delay) / 48000.0)));
+        }
+    }
+    check((tier + " roundTrip:errorDB").c_str(), linearToDb(error), -240.0, -60.0);
+}
+
+static void checkSlidingWindowMax(int window) {
+    SlidingWindowMax<double> hold(window);
+    hold.setWindow(window);
+    std::mt19937 rng(window);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<double> values;
+    int mismatches = 0;
+    for (int i = 0; i < 5000; ++i) {
+        values.push_back(i % 500 < 250 ? dist(rng) : 1.0 - i % 250 / 250.0);  // Noise, then a falling ramp
+        double expected = *std::max_element(values.begin() + std::max(0, i + 1 - window), values.end());
+        if (hold.push(values.back()) != expected) mismatches++;
+    }
+    check(("slidingMax" + std::to_string(window) + ":mismatches").c_str(), mismatches, 0, 0);
+}
+
+// Quiet tone, then a +15 dB burst at input sample BURST: the gain must ramp
+// down across the look-ahead span and reach the burst's reduction as the
+// burst reaches the delayed audio path, with no true-peak overshoot
+static void checkLookAhead() {
+    const int BURST = 6000;
+    TruePeakLimiter<double> limiter;
+    limiter.setSampleRate(48000.0);
+    limiter.setThreshold(-1.0);
+    const int span = static_cast<int>(0.05 * 48000.0);
+
+    double beforeDB = 1.0, rampDB = 0.0, fullDB = 0.0;
+    for (int i = 0; i < BURST + 2 * span; ++i) {
+        double amplitude = i >= BURST && i < BURST + span / 4 ? 2.0 : 0.35;
+        double l = amplitude * std::sin(2.0 * PI * 1000.0 * i / 48000.0), r = -l;
+        limiter.processStereo(l, r);
+        if (i == BURST - 100) beforeDB = limiter.getGainReduction();
+        if (i == BURST + span / 2) rampDB = limiter.getGainReduction();
+        if (i == BURST + span + 100) fullDB = limiter.getGainReduction();
+    }
+    const double fullReduction = linearToDb(dbToLinear(-1.0) / 2.0);
+    check("lookAhead:beforeBurstDB", beforeDB, -0.001, 0.0);
+    check("lookAhead:midRampDB", rampDB, linearToDb((1.0 + dbToLinear(fullReduction)) / 2.0) - 0.3,
+          linearToDb((1.0 + dbToLinear(fullReduction)) / 2.0) + 0.3);
+    check("lookAhead:fullReductionDB", fullDB, fullReduction - 0.1, fullReduction + 0.1);
+    check("lookAhead:truePeakDB", limiter.getTruePeak(), -1.1, -1.0 + 1e-9);
+}
+
+// A click comes out exactly getLatencySamples() later (look-ahead + FIR
+// round trip), at any rate and look-ahead, with the delay line reused
+static void checkLatency() {
+    TruePeakLimiter<double, ExportQuality> limiter;
+    limiter.setThreshold(6.0);
+    int mismatches = 0;
+    for (double rate : {44100.0, 96000.0, 192000.0}) {
+        for (double lookAhead : {0.0, 2.5, 50.0}) {
+            limiter.setSampleRate(rate);
+            limiter.setLookAhead(lookAhead);
+            limiter.reset();
+            int expected = static_cast<int>(std::lround(lookAhead * 0.001 * rate)) + 16;
+            int peakIndex = 0;
+            double peak = 0.0;
+            for (int i = 0; i < 12000; ++i) {
+                double l = i == 100 ? 0.5 : 0.0, r = l;
+                limiter.processStereo(l, r);
+                if (std::abs(l) > peak) {
+                    peak = std::abs(l);
+                    peakIndex = i;
+                }
+            }
+            if (limiter.getLatencySamples() != expected || peakIndex - 100 != expected) mismatches++;
+        }
+    }
+    check("latency:mismatches", mismatches, 0, 0);
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("Polyphase oversampler / true peak\n");
+    std::printf("========================================\n");
+
+    checkTier<RealtimePreviewQuality>();
+    checkTier<StandardQuality>();
+    checkTier<ExportQuality>();
+    checkHalfBand<2>();
+    checkHalfBand<4>();
+    checkHalfBand<8>();
+
+    // The limiter meters inter-sample overs (old code reported the sample peak).
+    // The tone fades in so the onset's interpolation overshoot stays out of the meter.
+    {
+        TruePeakLimiter<double> limiter;
+        limiter.setThreshold(6.0);  // Out of the way: metering only
+        for (int i = 0; i < 48000; ++i) {
+            double fade = std::min(1.0, i / 480.0);
+            double l = 0.9 * fade * std::sin(PI / 2.0 * i + PI / 4.0), r = l;
+            limiter.processStereo(l, r);
+        }
+        check("limiter:truePeakDB", limiter.getTruePeak(), linearToDb(0.9) - 0.1, linearToDb(0.9) + 0.1);
+    }
+
+    // Same meter through the half-band filter, with its shorter latency
+    {
+        TruePeakLimiter<double> limiter;
+        limiter.setThreshold(6.0);
+        limiter.setOversamplingFilter(OVERSAMPLING_HALF_BAND_IIR);
+        for (int i = 0; i < 48000; ++i) {
+            double fade = std::min(1.0, i / 480.0);
+            double l = 0.9 * fade * std::sin(PI / 2.0 * i + PI / 4.0), r = l;
+            limiter.processStereo(l, r);
+        }
+        check("limiter:halfBandTruePeakDB", limiter.getTruePeak(), linearToDb(0.9) - 0.1, linearToDb(0.9) + 0.1);
+        check("limiter:halfBandLatency", limiter.getOversamplingLatency(), 1, 4);
+    }
+
+    checkSlidingWindowMax(1);
+    checkSlidingWindowMax(7);
+    checkSlidingWindowMax(300);
+    checkLookAhead();
+    checkLatency();
+
+    return testSummary();
+}
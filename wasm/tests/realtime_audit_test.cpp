@@ -0,0 +1,266 @@
+/*
+ * Realtime-safety audit test
+ * The allocation trap must count operator new and (on glibc) malloc made
+ * inside a RealtimeScope, record the innermost scope label and a
+ * backtrace, and ignore allocations outside scopes or on other threads.
+ * Then every public method of each engine build, including full renders
+ * through the per-sample, block and streaming paths, the parameter queue
+ * and every meter, must run under a scope without touching the heap.
+ * Construction is the one exception and stays outside.
+ *
+ * Build: cmake -S .. -B build && cmake --build build && ctest --test-dir build
+ */
+
+#include "MasteringEngine.h"
+#include "RealtimeAudit.h"
+#include "TestCheck.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int QUANTUM = 128;
+
+// Keeps test allocations observable so the compiler cannot elide them
+static void* volatile escape = nullptr;
+
+static void checkTrap() {
+    resetRealtimeAudit();
+    {
+        std::vector<double> outside(64);
+        escape = outside.data();
+    }
+    check("trap:outsideScope", static_cast<double>(realtimeAuditViolations()), 0, 0);
+
+    {
+        RealtimeScope outer("outer");
+        {
+            RealtimeScope inner("inner");
+            std::vector<double> values(64);
+            escape = values.data();
+        }
+        int* single = new int(7);
+        escape = single;
+        delete single;
+    }
+    check("trap:insideScope", static_cast<double>(realtimeAuditViolations()), 2, 2);
+    check("trap:records", realtimeAuditRecordCount(), 2, 2);
+
+    const RealtimeAuditRecord& first = realtimeAuditRecord(0);
+    const RealtimeAuditRecord& second = realtimeAuditRecord(1);
+    check("trap:innerLabel", std::strcmp(first.scope, "inner") == 0 ? 1.0 : 0.0, 1.0, 1.0);
+    check("trap:outerLabel", std::strcmp(second.scope, "outer") == 0 ? 1.0 : 0.0, 1.0, 1.0);
+    check("trap:bytes", static_cast<double>(first.bytes), 64 * sizeof(double), 64 * sizeof(double));
+    check("trap:function", std::strcmp(first.function, "operator new") == 0 ? 1.0 : 0.0, 1.0, 1.0);
+    check("trap:backtrace", first.frameCount, 1, 16);
+
+#if defined(__GLIBC__)
+    resetRealtimeAudit();
+    {
+        RealtimeScope realtime("malloc");
+        void* block = std::malloc(100);
+        escape = block;
+        std::free(block);
+    }
+    check("trap:malloc", static_cast<double>(realtimeAuditViolations()), 1, 1);
+    check("trap:mallocFunction", std::strcmp(realtimeAuditRecord(0).function, "malloc") == 0 ? 1.0 : 0.0, 1.0, 1.0);
+#endif
+
+    // Scopes are per thread: a main-thread allocation while the audio
+    // thread sits in a scope is fine
+    resetRealtimeAudit();
+    std::atomic<int> stage{0};
+    std::thread worker([&] {
+        while (stage.load() != 1) std::this_thread::yield();
+        std::vector<double> values(64);
+        escape = values.data();
+        stage.store(2);
+    });
+    {
+        RealtimeScope realtime("audio thread");
+        stage.store(1);
+        while (stage.load() != 2) std::this_thread::yield();
+    }
+    worker.join();
+    check("trap:otherThread", static_cast<double>(realtimeAuditViolations()), 0, 0);
+    resetRealtimeAudit();
+}
+
+// 110 Hz + 3.5 kHz at the given amplitude
+static void fillProgramme(std::vector<float>& left, std::vector<float>& right, double amplitude) {
+    for (size_t i = 0; i < left.size(); ++i) {
+        double t = i / SAMPLE_RATE;
+        left[i] = static_cast<float>(amplitude * (0.7 * std::sin(2.0 * PI * 110.0 * t) + 0.3 * std::sin(2.0 * PI * 3500.0 * t)));
+        right[i] = static_cast<float>(amplitude * (0.7 * std::sin(2.0 * PI * 110.0 * t + 0.2) + 0.3 * std::sin(2.0 * PI * 3500.0 * t)));
+    }
+}
+
+template <typename Engine>
+static void checkEngine(const char* name) {
+    using Sample = typename Engine::SampleType;
+    auto engine = std::make_unique<Engine>(SAMPLE_RATE);
+    const int frames = static_cast<int>(SAMPLE_RATE * 3);
+    std::vector<float> loud(frames), loudR(frames), scratchL(frames), scratchR(frames);
+    fillProgramme(loud, loudR, 1.0);
+    bool warnedQuiet = false, warnedLoud = false;
+    double meters = 0.0;
+
+    resetRealtimeAudit();
+    auto audited = [&](const char* method, auto&& body) {
+        uint64_t before = realtimeAuditViolations();
+        {
+            RealtimeScope realtime(method);
+            body();
+        }
+        if (realtimeAuditViolations() != before) {
+            std::printf("  %s::%s allocated\n", name, method);
+        }
+    };
+
+    // Control methods, directly and through the queue
+    audited("setSampleRate", [&] { engine->setSampleRate(44100.0); engine->setSampleRate(SAMPLE_RATE); });
+    audited("setDCOffsetFilterEnabled", [&] { engine->setDCOffsetFilterEnabled(true); });
+    audited("setInputGain", [&] { engine->setInputGain(3.0); });
+    audited("setInputGainImmediate", [&] { engine->setInputGainImmediate(0.0); });
+    audited("setEQGain", [&] { engine->setEQGain(3, 2.0); });
+    audited("setAllEQGains", [&] { engine->setAllEQGains({2.0, -1.0, 0.5, 0.0, 1.5, -2.0, 3.0}); });
+    audited("setDeEsserEnabled", [&] { engine->setDeEsserEnabled(true); });
+    audited("setDeEsserThreshold", [&] { engine->setDeEsserThreshold(-30.0); });
+    audited("setDeEsserRatio", [&] { engine->setDeEsserRatio(4.0); });
+    audited("setMultibandEnabled", [&] { engine->setMultibandEnabled(true); });
+    audited("setMultibandLowBand", [&] { engine->setMultibandLowBand(-20.0, 2.0); });
+    audited("setMultibandMidBand", [&] { engine->setMultibandMidBand(-18.0, 2.5); });
+    audited("setMultibandHighBand", [&] { engine->setMultibandHighBand(-16.0, 3.0); });
+    audited("setMultibandKnee", [&] { engine->setMultibandKnee(6.0); });
+    audited("setMultibandStereoLink", [&] { engine->setMultibandStereoLink(false); });
+    audited("setStereoWidth", [&] { engine->setStereoWidth(1.4); });
+    audited("setSaturationDrive", [&] { engine->setSaturationDrive(2.0); });
+    audited("setSaturationMix", [&] { engine->setSaturationMix(0.3); });
+    audited("setLimiterThreshold", [&] { engine->setLimiterThreshold(-1.0); });
+    audited("setLimiterRelease", [&] { engine->setLimiterRelease(0.1); });
+    audited("setLimiterSafeClipMode", [&] { engine->setLimiterSafeClipMode(true); });
+    audited("setLowLatencyOversampling", [&] { engine->setLowLatencyOversampling(true); engine->setLowLatencyOversampling(false); });
+    audited("setLimiterLookAhead", [&] { engine->setLimiterLookAhead(5.0); engine->setLimiterLookAhead(DEFAULT_LOOKAHEAD_MS); });
+    audited("getLimiterLookAhead", [&] { meters += engine->getLimiterLookAhead(); });
+    audited("setDitheringEnabled", [&] { engine->setDitheringEnabled(true); });
+    audited("setDitheringBits", [&] { engine->setDitheringBits(16); });
+    audited("setDitheringNoiseShaping", [&] { engine->setDitheringNoiseShaping(1); });
+    audited("setAIEnabled", [&] { engine->setAIEnabled(true); });
+    audited("pushParameter", [&] {
+        for (int id = 0; id < static_cast<int>(PARAM_COUNT); ++id) {
+            engine->pushParameter(id, id % 3, id == PARAM_DITHERING_BITS ? 16.0 : 1.0);
+        }
+    });
+    audited("applyPendingCommands", [&] { engine->applyPendingCommands(); });
+    audited("applyCommand", [&] { engine->applyCommand(ParameterCommand{PARAM_STEREO_WIDTH, 0, 1.2}); });
+    audited("getCommandQueuePtr", [&] { escape = reinterpret_cast<void*>(engine->getCommandQueuePtr()); });
+    audited("applyAIAdjustments", [&] { engine->applyAIAdjustments(); });
+
+    // Rendering: per sample, planar, the heap-buffer block call, streaming
+    audited("processStereo", [&] {
+        for (int i = 0; i < frames / 2; ++i) {
+            Sample left = loud[i], right = loudR[i];
+            engine->processStereo(left, right);
+        }
+    });
+    audited("processPlanar", [&] {
+        for (int offset = 0; offset + QUANTUM <= frames; offset += QUANTUM) {
+            engine->processPlanar(scratchL.data() + offset, scratchR.data() + offset, QUANTUM);
+        }
+    });
+    audited("processBlock", [&] {
+        float* left = reinterpret_cast<float*>(engine->getLeftBufferPtr());
+        float* right = reinterpret_cast<float*>(engine->getRightBufferPtr());
+        for (int offset = 0; offset + QUANTUM <= frames; offset += QUANTUM) {
+            std::memcpy(left, loud.data() + offset, QUANTUM * sizeof(float));
+            std::memcpy(right, loudR.data() + offset, QUANTUM * sizeof(float));
+            engine->processBlock(engine->getLeftBufferPtr(), engine->getRightBufferPtr(), QUANTUM);
+        }
+    });
+    audited("getMaxBlockSize", [&] { meters += engine->getMaxBlockSize(); });
+    audited("setInternalBlockSize", [&] { engine->setInternalBlockSize(512, QUANTUM); });
+    audited("resetStream", [&] { engine->resetStream(QUANTUM); });
+    audited("processQueued", [&] {
+        auto* input = reinterpret_cast<AudioRingBuffer*>(engine->getInputRingPtr());
+        auto* output = reinterpret_cast<AudioRingBuffer*>(engine->getOutputRingPtr());
+        for (int offset = 0; offset + QUANTUM <= frames; offset += QUANTUM) {
+            input->write(loud.data() + offset, loudR.data() + offset, QUANTUM);
+            engine->processQueued();
+            output->read(scratchL.data(), scratchR.data(), QUANTUM);
+        }
+    });
+    audited("getInternalBlockSize", [&] { meters += engine->getInternalBlockSize(); });
+    audited("getStreamLatencySamples", [&] { meters += engine->getStreamLatencySamples(); });
+
+    // Meters
+    audited("getIntegratedLUFS", [&] { meters += engine->getIntegratedLUFS(); });
+    audited("getShortTermLUFS", [&] { meters += engine->getShortTermLUFS(); });
+    audited("getMomentaryLUFS", [&] { meters += engine->getMomentaryLUFS(); });
+    audited("getLRA", [&] { meters += engine->getLRA(); });
+    audited("getPhaseCorrelation", [&] { meters += engine->getPhaseCorrelation(); });
+    audited("getCrestFactor", [&] { meters += engine->getCrestFactor(); });
+    audited("getLimiterGainReduction", [&] { meters += engine->getLimiterGainReduction(); });
+    audited("getPeakDB", [&] { meters += engine->getPeakDB(); });
+    audited("getRMSDB", [&] { meters += engine->getRMSDB(); });
+    audited("getDeEsserGainReduction", [&] { meters += engine->getDeEsserGainReduction(); });
+    audited("getTruePeakDB", [&] { meters += engine->getTruePeakDB(); });
+    audited("advanceMeterClock", [&] { engine->advanceMeterClock(4096); });
+    audited("publishMeterSnapshot", [&] { engine->publishMeterSnapshot(); });
+    audited("readMeterSnapshot", [&] {
+        MeterSnapshot snapshot;
+        engine->readMeterSnapshot(snapshot);
+        meters += snapshot.integratedLUFS;
+    });
+    audited("getMeterSnapshotPtr", [&] { escape = reinterpret_cast<void*>(engine->getMeterSnapshotPtr()); });
+    audited("getLatencySamples", [&] { meters += engine->getLatencySamples(); });
+
+    // Every loudness warning the health analyzer can switch to
+    audited("reset", [&] { engine->reset(); });
+    audited("getMixHealthReport", [&] {
+        engine->setAIEnabled(false);
+        engine->setInputGain(0.0);
+        fillProgramme(scratchL, scratchR, 0.005);
+        for (int offset = 0; offset + QUANTUM <= frames; offset += QUANTUM) {
+            engine->processPlanar(scratchL.data() + offset, scratchR.data() + offset, QUANTUM);
+        }
+        warnedQuiet = std::strcmp(engine->getMixHealthReport().lufsWarning, "Way Too Quiet") == 0;
+        engine->reset();
+        engine->setInputGain(12.0);
+        engine->setLimiterThreshold(-0.1);
+        fillProgramme(scratchL, scratchR, 1.0);
+        for (int offset = 0; offset + QUANTUM <= frames; offset += QUANTUM) {
+            engine->processPlanar(scratchL.data() + offset, scratchR.data() + offset, QUANTUM);
+        }
+        warnedLoud = std::strcmp(engine->getMixHealthReport().lufsWarning, "Way Too Loud") == 0;
+    });
+
+    std::string label = name;
+    check((label + " meters:finite").c_str(), std::isfinite(meters) ? 1.0 : 0.0, 1.0, 1.0);
+    check((label + " health:quietWarning").c_str(), warnedQuiet ? 1.0 : 0.0, 1.0, 1.0);
+    check((label + " health:loudWarning").c_str(), warnedLoud ? 1.0 : 0.0, 1.0, 1.0);
+    if (!check((label + " violations").c_str(), static_cast<double>(realtimeAuditViolations()), 0, 0)) {
+        printRealtimeAuditReport(stdout);
+    }
+    resetRealtimeAudit();
+}
+
+int main() {
+    std::printf("========================================\n");
+    std::printf("Realtime-safety audit\n");
+    std::printf("========================================\n");
+
+    checkTrap();
+    checkEngine<MasteringEngine>("MasteringEngine");
+    checkEngine<MasteringEngineF32>("MasteringEngineF32");
+    checkEngine<MasteringEnginePreview>("MasteringEnginePreview");
+    checkEngine<MasteringEngineExport>("MasteringEngineExport");
+
+    return testSummary();
+}
@@ -0,0 +1,197 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Batch Scheduler (work-stealing pool + I/O back-pressure)
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Coarse-grained scheduler for catalog renders: one job = one whole file.
+ *
+ * - WorkStealingPool: persistent workers, one deque each. Owners pop from the
+ *   back, idle workers steal from the front of a victim's deque, so a worker
+ *   stuck on a long track never leaves the others idle while work remains.
+ * - IOGate: counting semaphore bounding how many workers may be inside file
+ *   reads/writes at once, so 16 renderers do not thrash one disk.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// I/O GATE (counting semaphore)
+// ═══════════════════════════════════════════════════════════════════════════
+
+class IOGate {
+private:
+    std::mutex mutex;
+    std::condition_variable available;
+    int permits;
+
+public:
+    explicit IOGate(int maxConcurrent) : permits(std::max(1, maxConcurrent)) {}
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [this] { return permits > 0; });
+        --permits;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++permits;
+        }
+        available.notify_one();
+    }
+
+    // RAII permit; a null gate means unlimited
+    class Scope {
+    private:
+        IOGate* gate;
+
+    public:
+        explicit Scope(IOGate* g) : gate(g) {
+            if (gate) gate->acquire();
+        }
+        ~Scope() {
+            if (gate) gate->release();
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WORK-STEALING POOL
+// ═══════════════════════════════════════════════════════════════════════════
+
+class WorkStealingPool {
+public:
+    // Called on a worker thread with the worker's index and the job index
+    using JobFunction = std::function<void(int worker, size_t job)>;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<size_t> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex stateMutex;
+    std::condition_variable workReady;
+    std::condition_variable batchDone;
+    const JobFunction* currentJob = nullptr;
+    uint64_t generation = 0;
+    int activeWorkers = 0;
+    bool stopping = false;
+    std::atomic<size_t> remaining{0};
+    std::atomic<size_t> steals{0};
+
+    bool popLocal(int worker, size_t& job) {
+        WorkerQueue& queue = *queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) return false;
+        job = queue.jobs.back();
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool steal(int thief, size_t& job) {
+        const int count = static_cast<int>(queues.size());
+        for (int offset = 1; offset < count; ++offset) {
+            WorkerQueue& victim = *queues[(thief + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(int worker) {
+        uint64_t seenGeneration = 0;
+        while (true) {
+            const JobFunction* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                workReady.wait(lock, [&] { return stopping || generation != seenGeneration; });
+                if (stopping) return;
+                seenGeneration = generation;
+                job = currentJob;
+            }
+
+            size_t index;
+            while (remaining.load(std::memory_order_acquire) > 0 &&
+                   (popLocal(worker, index) || steal(worker, index))) {
+                (*job)(worker, index);
+                remaining.fetch_sub(1, std::memory_order_acq_rel);
+            }
+
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (--activeWorkers == 0) batchDone.notify_all();
+        }
+    }
+
+public:
+    explicit WorkStealingPool(int workerCount) {
+        workerCount = std::max(1, workerCount);
+        for (int i = 0; i < workerCount; ++i) {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        for (int i = 0; i < workerCount; ++i) {
+            threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        workReady.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int getWorkerCount() const { return static_cast<int>(threads.size()); }
+    size_t getStealCount() const { return steals.load(std::memory_order_relaxed); }
+
+    // Run jobs in `order` (e.g. largest file first) and block until all have
+    // finished. Jobs are dealt round-robin so each worker starts on its own
+    // share; stealing evens out the tail.
+    void run(const std::vector<size_t>& order, const JobFunction& job) {
+        if (order.empty()) return;
+
+        const int count = getWorkerCount();
+        for (size_t i = 0; i < order.size(); ++i) {
+            WorkerQueue& queue = *queues[i % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_front(order[i]);  // Owner pops the back: first dealt runs first
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+        remaining.store(order.size(), std::memory_order_release);
+        currentJob = &job;
+        activeWorkers = count;
+        ++generation;
+        workReady.notify_all();
+        batchDone.wait(lock, [this] { return activeWorkers == 0; });
+        currentJob = nullptr;
+    }
+};
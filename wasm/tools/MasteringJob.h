@@ -0,0 +1,246 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Mastering Job (one file through the engine)
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Streams one WAV file through the export-quality engine (8x true-peak
+ * oversampling, MasteringEngineExport) with multi-pass loudness
+ * normalization. Shared by the single-file CLI and the batch scheduler;
+ * the caller owns the engine storage so a batch worker reuses one instance.
+ *
+ * File I/O happens in large chunks under an optional IOGate (back-pressure);
+ * the engine processes each chunk in blockSize slices. The engine's latency
+ * is compensated: its first getLatencySamples() output frames are dropped
+ * and the tail is flushed with silence, so the output file has the input's
+ * length and timing.
+ */
+
+#pragma once
+
+#include "BatchScheduler.h"
+#include "MasteringEngine.h"
+#include "MasteringPreset.h"
+#include "WavFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct MasteringJobOptions {
+    int bits = 24;              // 16 / 24 (dithered PCM) or 32 (float)
+    NoiseShaping noiseShaping = NOISE_SHAPING_FLAT;
+    double lookAheadMs = DEFAULT_LOOKAHEAD_MS;  // Limiter look-ahead
+    int blockSize = 512;        // Engine block size
+    int maxPasses = 4;
+    bool normalize = true;
+    bool verbose = false;       // Per-pass progress on stderr
+};
+
+struct MasteringJobResult {
+    std::string inputFile;
+    std::string outputFile;
+    bool success = false;
+    std::string error;
+    double integratedLUFS = -70.0;
+    double truePeakDB = -100.0;
+    double loudnessRange = 0.0;
+    double trimDB = 0.0;
+    int passes = 0;
+    double durationSeconds = 0.0;   // Audio length
+    double renderSeconds = 0.0;     // Wall-clock time for all passes
+    int worker = -1;
+};
+
+class MasteringJob {
+public:
+    using Engine = MasteringEngineExport;
+
+private:
+    constexpr static double MAX_NORMALIZE_TRIM = 24.0;     // dB either way
+    constexpr static double NORMALIZE_TOLERANCE_LU = 0.3;
+    constexpr static double MIN_NORMALIZE_SLOPE = 0.1;     // LU per dB of trim
+    constexpr static size_t IO_CHUNK_FRAMES = 65536;
+
+    std::vector<float> chunkL;
+    std::vector<float> chunkR;
+
+    struct PassResult {
+        double integratedLUFS;
+        double truePeakDB;
+        double loudnessRange;
+    };
+
+    // One full pass: a freshly constructed engine in the caller's storage,
+    // so every pass (and every job on a worker) starts from the same state
+    PassResult renderPass(WavReader& reader, WavWriter& writer, const PlatformPreset& preset,
+                          double trimDB, const MasteringJobOptions& options,
+                          std::optional<Engine>& engine, IOGate* io) {
+        engine.emplace(reader.getSampleRate());
+        applyPlatformPreset(*engine, preset);
+        engine->setInputGainImmediate(trimDB);
+        engine->setDitheringEnabled(options.bits != 32);
+        if (options.bits != 32) engine->setDitheringBits(options.bits);
+        engine->setDitheringNoiseShaping(options.noiseShaping);
+        engine->setLimiterLookAhead(options.lookAheadMs);
+
+        {
+            IOGate::Scope permit(io);
+            reader.rewind();
+        }
+
+        // Runs `frames` of the chunk through the engine and writes what is
+        // left after the latency still to be skipped
+        size_t skip = static_cast<size_t>(engine->getLatencySamples());
+        auto renderChunk = [&](size_t frames) {
+            for (size_t offset = 0; offset < frames; offset += options.blockSize) {
+                int count = static_cast<int>(std::min<size_t>(options.blockSize, frames - offset));
+                engine->processPlanar(chunkL.data() + offset, chunkR.data() + offset, count);
+            }
+            size_t skipped = std::min(skip, frames);
+            skip -= skipped;
+            if (skipped == frames) return;
+
+            IOGate::Scope permit(io);
+            writer.write(chunkL.data() + skipped, chunkR.data() + skipped, frames - skipped);
+        };
+
+        while (true) {
+            size_t frames;
+            {
+                IOGate::Scope permit(io);
+                frames = reader.read(chunkL.data(), chunkR.data(), IO_CHUNK_FRAMES);
+            }
+            if (frames == 0) break;
+            renderChunk(frames);
+        }
+
+        // Flush the delayed tail with silence
+        for (size_t tail = static_cast<size_t>(engine->getLatencySamples()); tail > 0;) {
+            size_t frames = std::min(tail, IO_CHUNK_FRAMES);
+            std::fill(chunkL.begin(), chunkL.begin() + frames, 0.0f);
+            std::fill(chunkR.begin(), chunkR.begin() + frames, 0.0f);
+            renderChunk(frames);
+            tail -= frames;
+        }
+
+        return {engine->getIntegratedLUFS(), engine->getTruePeakDB(), engine->getLRA()};
+    }
+
+public:
+    MasteringJob() : chunkL(IO_CHUNK_FRAMES), chunkR(IO_CHUNK_FRAMES) {}
+
+    // Never throws: failures are reported in the result
+    MasteringJobResult run(const std::string& inputFile, const std::string& outputFile,
+                           const PlatformPreset& preset, const MasteringJobOptions& options,
+                           std::optional<Engine>& engine, IOGate* io = nullptr) {
+        MasteringJobResult result;
+        result.inputFile = inputFile;
+        result.outputFile = outputFile;
+        const auto start = std::chrono::steady_clock::now();
+
+        try {
+            std::optional<WavReader> reader;
+            {
+                IOGate::Scope permit(io);
+                reader.emplace(inputFile);
+            }
+            result.durationSeconds = static_cast<double>(reader->getTotalFrames()) / reader->getSampleRate();
+
+            const WavWriter::SampleFormat format = options.bits == 16 ? WavWriter::PCM_16
+                                                 : options.bits == 24 ? WavWriter::PCM_24
+                                                 : WavWriter::FLOAT_32;
+
+            // Re-render with a corrected input trim until the output lands
+            // within tolerance of the platform target
+            double trimDB = 0.0;
+            double previousTrim = 0.0;
+            double previousLUFS = 0.0;
+            PassResult pass{};
+            while (true) {
+                std::optional<WavWriter> writer;
+                {
+                    IOGate::Scope permit(io);
+                    writer.emplace(outputFile, reader->getSampleRate(), format);
+                }
+                pass = renderPass(*reader, *writer, preset, trimDB, options, engine, io);
+                {
+                    IOGate::Scope permit(io);
+                    writer->close();
+                }
+                ++result.passes;
+                if (options.verbose) {
+                    std::fprintf(stderr, "  Pass %d: trim %+.2f dB -> %.2f LUFS\n",
+                                 result.passes, trimDB, pass.integratedLUFS);
+                }
+
+                double error = preset.targetLUFS - pass.integratedLUFS;
+                if (!options.normalize || result.passes >= options.maxPasses ||
+                    std::abs(error) <= NORMALIZE_TOLERANCE_LU ||
+                    pass.integratedLUFS <= LoudnessHistogram::ABSOLUTE_GATE) {
+                    break;
+                }
+
+                // Compression and limiting flatten the response, so after the
+                // first pass step along the measured LUFS-per-dB slope (secant)
+                double slope = 1.0;
+                if (result.passes > 1 && std::abs(trimDB - previousTrim) > 1e-6) {
+                    slope = (pass.integratedLUFS - previousLUFS) / (trimDB - previousTrim);
+                    slope = std::max(MIN_NORMALIZE_SLOPE, std::min(1.0, slope));
+                }
+                double nextTrim = std::max(-MAX_NORMALIZE_TRIM,
+                                           std::min(MAX_NORMALIZE_TRIM, trimDB + error / slope));
+                if (std::abs(nextTrim - trimDB) < 1e-3) break;  // Pinned at the trim limit
+
+                previousTrim = trimDB;
+                previousLUFS = pass.integratedLUFS;
+                trimDB = nextTrim;
+            }
+
+            result.integratedLUFS = pass.integratedLUFS;
+            result.truePeakDB = pass.truePeakDB;
+            result.loudnessRange = pass.loudnessRange;
+            result.trimDB = trimDB;
+            result.success = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+
+        result.renderSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+};
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (c == '\n') {
+            escaped += "\\n";
+            continue;
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// One JSON line per job (same keys as the single-file result)
+inline void printJobResultJSON(std::FILE* out, const MasteringJobResult& result, const PlatformPreset& preset) {
+    if (!result.success) {
+        std::fprintf(out, "{\"success\": false, \"input_file\": \"%s\", \"error\": \"%s\"}\n",
+                     jsonEscape(result.inputFile).c_str(), jsonEscape(result.error).c_str());
+        return;
+    }
+    const double realtimeFactor = result.renderSeconds > 0.0 ? result.durationSeconds / result.renderSeconds : 0.0;
+    std::fprintf(out, "{\"success\": true, \"input_file\": \"%s\", \"output_file\": \"%s\", \"platform\": \"%s\", "
+                      "\"target_lufs\": %.2f, \"true_peak\": %.2f, \"integrated_lufs\": %.2f, "
+                      "\"measured_true_peak\": %.2f, \"loudness_range\": %.2f, \"trim_db\": %.2f, \"passes\": %d, "
+                      "\"duration_seconds\": %.3f, \"render_seconds\": %.3f, \"realtime_factor\": %.1f, \"worker\": %d}\n",
+                 jsonEscape(result.inputFile).c_str(), jsonEscape(result.outputFile).c_str(),
+                 preset.platform.c_str(), preset.targetLUFS, preset.truePeak, result.integratedLUFS,
+                 result.truePeakDB, result.loudnessRange, result.trimDB, result.passes,
+                 result.durationSeconds, result.renderSeconds, realtimeFactor, result.worker);
+}
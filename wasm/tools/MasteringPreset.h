@@ -0,0 +1,278 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Platform Presets for the Native Renderer
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Platform targets ported from master_audio_ultimate.py
+ * (UltimateMasteringEngine.get_platform_optimized_params), the same user
+ * parameters (bass / mids / highs / width / compression / warmth / loudness)
+ * and a minimal JSON reader for preset files. Errors throw std::runtime_error.
+ */
+
+#pragma once
+
+#include "MasteringEngine.h"
+
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// USER PARAMETERS (flat JSON object)
+// ═══════════════════════════════════════════════════════════════════════════
+// Numbers, booleans and strings at the top level; arrays of numbers are
+// stored as "key[0]", "key[1]", ... (e.g. "eq": [7 gains]). Nested objects
+// are rejected.
+//
+//   { "platform": "apple", "bass": 1.5, "width": 110, "eq": [0,1,0,0,0,1,0] }
+
+struct UserParams {
+    std::map<std::string, double> numbers;
+    std::map<std::string, std::string> strings;
+
+    bool has(const std::string& key) const { return numbers.count(key) != 0; }
+
+    double get(const std::string& key, double fallback) const {
+        auto it = numbers.find(key);
+        return it != numbers.end() ? it->second : fallback;
+    }
+
+    // Later values (e.g. command-line flags) override earlier ones
+    void merge(const UserParams& other) {
+        for (const auto& entry : other.numbers) numbers[entry.first] = entry.second;
+        for (const auto& entry : other.strings) strings[entry.first] = entry.second;
+    }
+};
+
+class PresetJSONParser {
+private:
+    const std::string& text;
+    size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error("preset JSON: " + message + " at offset " + std::to_string(pos));
+    }
+
+    void skipWhitespace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+    }
+
+    void expect(char c) {
+        skipWhitespace();
+        if (pos >= text.size() || text[pos] != c) fail(std::string("expected '") + c + "'");
+        ++pos;
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (pos < text.size() && text[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(const char* word) {
+        size_t length = std::char_traits<char>::length(word);
+        if (text.compare(pos, length, word) == 0) {
+            pos += length;
+            return true;
+        }
+        return false;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string result;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\') {
+                if (pos >= text.size()) break;
+                char escaped = text[pos++];
+                switch (escaped) {
+                    case 'n': result += '\n'; break;
+                    case 't': result += '\t'; break;
+                    case 'u': fail("\\u escapes are not supported");
+                    default:  result += escaped; break;
+                }
+            } else {
+                result += c;
+            }
+        }
+        if (pos >= text.size()) fail("unterminated string");
+        ++pos;
+        return result;
+    }
+
+    double parseNumber() {
+        skipWhitespace();
+        const char* start = text.c_str() + pos;
+        char* end = nullptr;
+        double value = std::strtod(start, &end);
+        if (end == start) fail("expected a value");
+        pos += static_cast<size_t>(end - start);
+        return value;
+    }
+
+    void parseValue(const std::string& key, UserParams& params) {
+        skipWhitespace();
+        if (pos >= text.size()) fail("unexpected end of input");
+
+        char c = text[pos];
+        if (c == '"') {
+            params.strings[key] = parseString();
+        } else if (c == '[') {
+            ++pos;
+            int index = 0;
+            if (!consume(']')) {
+                do {
+                    params.numbers[key + "[" + std::to_string(index++) + "]"] = parseNumber();
+                } while (consume(','));
+                expect(']');
+            }
+        } else if (c == '{') {
+            fail("nested objects are not supported");
+        } else if (consumeWord("true")) {
+            params.numbers[key] = 1.0;
+        } else if (consumeWord("false")) {
+            params.numbers[key] = 0.0;
+        } else if (consumeWord("null")) {
+            // Treated as absent
+        } else {
+            params.numbers[key] = parseNumber();
+        }
+    }
+
+public:
+    explicit PresetJSONParser(const std::string& source) : text(source) {}
+
+    UserParams parse() {
+        UserParams params;
+        expect('{');
+        if (!consume('}')) {
+            do {
+                skipWhitespace();
+                std::string key = parseString();
+                expect(':');
+                parseValue(key, params);
+            } while (consume(','));
+            expect('}');
+        }
+        skipWhitespace();
+        if (pos != text.size()) fail("trailing characters");
+        return params;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLATFORM PRESETS (master_audio_ultimate.py::get_platform_optimized_params)
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct PlatformPreset {
+    std::string platform;
+    double targetLUFS = -14.0;
+    double truePeak = -1.0;             // dBTP
+    double bassBoost = 0.0;             // dB
+    double midsBoost = 0.0;             // dB
+    double highsBoost = 0.0;            // dB
+    double compressionRatio = 5.0;
+    double stereoWidth = 1.0;
+    double saturation = 0.2;            // 0..1
+    int dynamicRangeTarget = 8;         // dB
+    bool presenceBoost = false;
+    bool airEnhancement = false;
+    bool bassEnhancement = false;
+    bool loudnessMaximization = false;
+    std::array<double, 7> eqOffsets{};  // Optional "eq": [7 gains] from the preset file
+};
+
+// Map the 1-10 compression slider to a ratio (same table as the Python engine)
+inline double mapCompression(int level) {
+    constexpr std::array<double, 10> ratios = {1.5, 2.0, 2.5, 3.0, 4.0, 5.0, 6.0, 7.0, 8.5, 10.0};
+    return ratios[std::max(1, std::min(10, level)) - 1];
+}
+
+inline PlatformPreset getPlatformPreset(const std::string& platform, const UserParams& user) {
+    struct Defaults {
+        const char* name;
+        double targetLUFS, truePeak, bass, mids, highs;
+        int compression, width, warmth, dynamicRange;
+        bool presence, air, bassEnhancement, loudnessMax;
+    };
+    static const Defaults table[] = {
+        //  name          LUFS  TP    bass mids highs comp width warmth DR presence air  bassEnh loudMax
+        {"spotify",    -14, -1.0, 0.0, 0.0, 0.0,  5, 100, 20, 8,  false, false, false, false},
+        {"apple",      -16, -1.0, 0.0, 0.0, 0.0,  4, 100, 15, 10, false, true,  false, false},
+        {"youtube",    -14, -1.0, 0.0, 0.0, 0.0,  5, 100, 20, 8,  true,  false, false, false},
+        {"tidal",      -14, -1.0, 0.0, 0.0, 0.0,  4, 105, 10, 10, false, true,  false, false},
+        {"soundcloud", -11, -0.5, 1.0, 0.0, 0.5,  6, 100, 30, 6,  true,  false, false, true},
+        {"deezer",     -15, -1.0, 0.0, 0.0, 0.0,  4, 100, 15, 9,  false, true,  false, false},
+        {"amazon",     -14, -2.0, 0.0, 0.0, 0.0,  5, 100, 20, 8,  false, false, false, false},
+        {"pandora",    -14, -2.0, 0.0, 0.5, 0.0,  5, 95,  25, 7,  true,  false, false, false},
+        {"radio",       -9, -0.3, 2.0, 1.0, 1.0,  8, 90,  40, 5,  true,  false, true,  true},
+    };
+
+    const Defaults* defaults = nullptr;
+    for (const Defaults& entry : table) {
+        if (platform == entry.name) defaults = &entry;
+    }
+    if (!defaults) throw std::runtime_error("unknown platform '" + platform + "'");
+
+    PlatformPreset preset;
+    preset.platform = defaults->name;
+    preset.targetLUFS = user.get("loudness", defaults->targetLUFS);
+    preset.truePeak = user.get("true_peak", defaults->truePeak);
+    preset.bassBoost = user.get("bass", defaults->bass);
+    preset.midsBoost = user.get("mids", defaults->mids);
+    preset.highsBoost = user.get("highs", defaults->highs);
+    preset.compressionRatio = mapCompression(static_cast<int>(user.get("compression", defaults->compression)));
+    preset.stereoWidth = static_cast<int>(user.get("width", defaults->width)) / 100.0;
+    preset.saturation = static_cast<int>(user.get("warmth", defaults->warmth)) / 100.0;
+    preset.dynamicRangeTarget = defaults->dynamicRange;
+    preset.presenceBoost = defaults->presence;
+    preset.airEnhancement = defaults->air;
+    preset.bassEnhancement = defaults->bassEnhancement;
+    preset.loudnessMaximization = defaults->loudnessMax;
+    for (int i = 0; i < 7; ++i) {
+        preset.eqOffsets[i] = user.get("eq[" + std::to_string(i) + "]", 0.0);
+    }
+    return preset;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PRESET → ENGINE
+// ═══════════════════════════════════════════════════════════════════════════
+// The Python chain's moves mapped onto the engine's stages:
+//   bass @ 100Hz → 120Hz band, mids @ 1kHz → 1kHz band, presence @ 3kHz →
+//   3.5kHz band, highs @ 8kHz → 8kHz band, air shelf @ 12kHz → 14kHz band;
+//   RMS compressor → multiband compressor (same threshold/ratio per band);
+//   tanh warmth → analog saturation; true peak → limiter ceiling.
+
+template <typename Engine>
+inline void applyPlatformPreset(Engine& engine, const PlatformPreset& preset) {
+    std::array<double, 7> gains = preset.eqOffsets;
+    gains[1] += preset.bassBoost + (preset.bassEnhancement ? 1.5 : 0.0);
+    gains[3] += preset.midsBoost + (preset.presenceBoost ? 0.5 : 0.0);
+    gains[4] += preset.presenceBoost ? 1.0 : 0.0;
+    gains[5] += preset.highsBoost;
+    gains[6] += preset.airEnhancement ? 0.5 : 0.0;
+    engine.setAllEQGains(gains);
+
+    // Adaptive threshold based on the dynamic range target
+    double threshold = -24.0 + (10 - preset.dynamicRangeTarget);
+    engine.setMultibandEnabled(true);
+    engine.setMultibandLowBand(threshold, preset.compressionRatio);
+    engine.setMultibandMidBand(threshold, preset.compressionRatio);
+    engine.setMultibandHighBand(threshold, preset.compressionRatio);
+
+    engine.setStereoWidth(preset.stereoWidth);
+
+    // Tube stage drive and wet blend from the Python harmonic enhancer
+    engine.setSaturationDrive(1.0 + preset.saturation * 2.0);
+    engine.setSaturationMix(preset.saturation * 0.6);
+
+    engine.setLimiterThreshold(preset.truePeak);
+}
@@ -0,0 +1,293 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Streaming WAV Reader / Writer
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Block-at-a-time RIFF/WAVE I/O for the native renderer. Memory use is one
+ * block of raw bytes regardless of file length.
+ *
+ * - Reads PCM 8/16/24/32-bit and IEEE float 32/64-bit, mono or stereo
+ *   (WAVE_FORMAT_EXTENSIBLE included); mono is duplicated to both channels
+ * - Writes stereo PCM 16/24-bit or float 32-bit
+ * - Little-endian hosts only (x86-64, AArch64, WASM)
+ * - Errors are reported with std::runtime_error
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WAV READER
+// ═══════════════════════════════════════════════════════════════════════════
+
+class WavReader {
+private:
+    constexpr static uint16_t FORMAT_PCM = 1;
+    constexpr static uint16_t FORMAT_FLOAT = 3;
+    constexpr static uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+    std::FILE* file = nullptr;
+    std::string path;
+    uint16_t format = 0;
+    uint16_t channels = 0;
+    uint32_t sampleRate = 0;
+    uint16_t bitsPerSample = 0;
+    uint32_t bytesPerFrame = 0;
+    long dataOffset = 0;
+    uint64_t totalFrames = 0;
+    uint64_t framesRead = 0;
+    std::vector<uint8_t> raw;
+
+    static uint16_t readU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+    static uint32_t readU32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error(path + ": " + message);
+    }
+
+    void readExact(void* buffer, size_t bytes) {
+        if (std::fread(buffer, 1, bytes, file) != bytes) fail("unexpected end of file");
+    }
+
+    void parseHeader() {
+        uint8_t riff[12];
+        readExact(riff, sizeof(riff));
+        if (std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+            fail("not a RIFF/WAVE file");
+        }
+
+        bool haveFormat = false;
+        uint8_t chunk[8];
+        while (std::fread(chunk, 1, sizeof(chunk), file) == sizeof(chunk)) {
+            uint32_t chunkSize = readU32(chunk + 4);
+            long paddedSize = static_cast<long>(chunkSize) + (chunkSize & 1);
+
+            if (std::memcmp(chunk, "fmt ", 4) == 0) {
+                if (chunkSize < 16) fail("truncated fmt chunk");
+                std::vector<uint8_t> fmt(chunkSize);
+                readExact(fmt.data(), chunkSize);
+                if (chunkSize & 1) std::fseek(file, 1, SEEK_CUR);
+
+                format = readU16(&fmt[0]);
+                channels = readU16(&fmt[2]);
+                sampleRate = readU32(&fmt[4]);
+                bitsPerSample = readU16(&fmt[14]);
+                if (format == FORMAT_EXTENSIBLE) {
+                    if (chunkSize < 26) fail("truncated WAVE_FORMAT_EXTENSIBLE header");
+                    format = readU16(&fmt[24]);  // First two bytes of the SubFormat GUID
+                }
+                haveFormat = true;
+            } else if (std::memcmp(chunk, "data", 4) == 0) {
+                if (!haveFormat) fail("data chunk before fmt chunk");
+                dataOffset = std::ftell(file);
+                bytesPerFrame = channels * (bitsPerSample / 8u);
+                if (bytesPerFrame == 0) fail("invalid frame size");
+                totalFrames = chunkSize / bytesPerFrame;
+                return;
+            } else {
+                std::fseek(file, paddedSize, SEEK_CUR);
+            }
+        }
+        fail("no data chunk");
+    }
+
+    void validate() const {
+        if (channels != 1 && channels != 2) fail("only mono and stereo files are supported");
+        if (sampleRate == 0) fail("invalid sample rate");
+        bool pcm = format == FORMAT_PCM &&
+                   (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32);
+        bool ieee = format == FORMAT_FLOAT && (bitsPerSample == 32 || bitsPerSample == 64);
+        if (!pcm && !ieee) fail("unsupported sample format");
+    }
+
+    double decodeSample(const uint8_t* p) const {
+        if (format == FORMAT_FLOAT) {
+            if (bitsPerSample == 32) {
+                float value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+            double value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        switch (bitsPerSample) {
+            case 8:  return (static_cast<int>(p[0]) - 128) / 128.0;
+            case 16: return static_cast<int16_t>(readU16(p)) / 32768.0;
+            case 24: {
+                int32_t value = static_cast<int32_t>(static_cast<uint32_t>(p[0]) << 8 |
+                                                     static_cast<uint32_t>(p[1]) << 16 |
+                                                     static_cast<uint32_t>(p[2]) << 24) >> 8;
+                return value / 8388608.0;
+            }
+            default: return static_cast<int32_t>(readU32(p)) / 2147483648.0;
+        }
+    }
+
+public:
+    explicit WavReader(const std::string& filePath) : path(filePath) {
+        file = std::fopen(filePath.c_str(), "rb");
+        if (!file) fail("cannot open for reading");
+        try {
+            parseHeader();
+            validate();
+        } catch (...) {
+            std::fclose(file);
+            throw;
+        }
+    }
+
+    ~WavReader() {
+        if (file) std::fclose(file);
+    }
+
+    WavReader(const WavReader&) = delete;
+    WavReader& operator=(const WavReader&) = delete;
+
+    // Read up to maxFrames planar stereo frames. Returns frames read (0 at EOF).
+    size_t read(float* left, float* right, size_t maxFrames) {
+        size_t frames = static_cast<size_t>(std::min<uint64_t>(maxFrames, totalFrames - framesRead));
+        if (frames == 0) return 0;
+
+        raw.resize(frames * bytesPerFrame);
+        frames = std::fread(raw.data(), bytesPerFrame, frames, file);
+        framesRead += frames;
+
+        const uint32_t bytesPerSample = bitsPerSample / 8u;
+        for (size_t i = 0; i < frames; ++i) {
+            const uint8_t* frame = raw.data() + i * bytesPerFrame;
+            left[i] = static_cast<float>(decodeSample(frame));
+            right[i] = (channels == 2) ? static_cast<float>(decodeSample(frame + bytesPerSample)) : left[i];
+        }
+        return frames;
+    }
+
+    // Seek back to the first frame (for multi-pass rendering)
+    void rewind() {
+        if (std::fseek(file, dataOffset, SEEK_SET) != 0) fail("seek failed");
+        framesRead = 0;
+    }
+
+    uint32_t getSampleRate() const { return sampleRate; }
+    uint16_t getChannels() const { return channels; }
+    uint64_t getTotalFrames() const { return totalFrames; }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WAV WRITER
+// ═══════════════════════════════════════════════════════════════════════════
+
+class WavWriter {
+public:
+    enum SampleFormat { PCM_16, PCM_24, FLOAT_32 };
+
+private:
+    constexpr static long HEADER_SIZE = 44;
+
+    std::FILE* file = nullptr;
+    std::string path;
+    SampleFormat sampleFormat;
+    uint32_t sampleRate;
+    uint64_t framesWritten = 0;
+    std::vector<uint8_t> raw;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw std::runtime_error(path + ": " + message);
+    }
+
+    uint32_t bytesPerSample() const { return sampleFormat == PCM_16 ? 2u : sampleFormat == PCM_24 ? 3u : 4u; }
+
+    static void putU16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+    static void putU32(uint8_t* p, uint32_t v) {
+        p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; p[2] = (v >> 16) & 0xFF; p[3] = v >> 24;
+    }
+
+    void writeHeader(uint32_t dataBytes) {
+        uint8_t header[HEADER_SIZE];
+        const uint16_t channels = 2;
+        const uint32_t blockAlign = channels * bytesPerSample();
+        std::memcpy(header, "RIFF", 4);
+        putU32(header + 4, 36 + dataBytes);
+        std::memcpy(header + 8, "WAVEfmt ", 8);
+        putU32(header + 16, 16);
+        putU16(header + 20, sampleFormat == FLOAT_32 ? 3 : 1);
+        putU16(header + 22, channels);
+        putU32(header + 24, sampleRate);
+        putU32(header + 28, sampleRate * blockAlign);
+        putU16(header + 32, static_cast<uint16_t>(blockAlign));
+        putU16(header + 34, static_cast<uint16_t>(bytesPerSample() * 8));
+        std::memcpy(header + 36, "data", 4);
+        putU32(header + 40, dataBytes);
+
+        if (std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(header, 1, HEADER_SIZE, file) != HEADER_SIZE) {
+            fail("cannot write header");
+        }
+    }
+
+    void encodeSample(uint8_t* p, float sample) const {
+        if (sampleFormat == FLOAT_32) {
+            std::memcpy(p, &sample, sizeof(sample));
+            return;
+        }
+
+        const double scale = (sampleFormat == PCM_16) ? 32768.0 : 8388608.0;
+        double scaled = std::round(static_cast<double>(sample) * scale);
+        int32_t value = static_cast<int32_t>(std::max(-scale, std::min(scale - 1.0, scaled)));
+        p[0] = value & 0xFF;
+        p[1] = (value >> 8) & 0xFF;
+        if (sampleFormat == PCM_24) p[2] = (value >> 16) & 0xFF;
+    }
+
+public:
+    WavWriter(const std::string& filePath, uint32_t rate, SampleFormat formatToWrite)
+        : path(filePath), sampleFormat(formatToWrite), sampleRate(rate) {
+        file = std::fopen(filePath.c_str(), "wb");
+        if (!file) fail("cannot open for writing");
+        writeHeader(0);
+    }
+
+    ~WavWriter() {
+        if (file) std::fclose(file);
+    }
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    void write(const float* left, const float* right, size_t frames) {
+        const uint32_t sampleBytes = bytesPerSample();
+        raw.resize(frames * 2 * sampleBytes);
+        for (size_t i = 0; i < frames; ++i) {
+            encodeSample(&raw[(i * 2) * sampleBytes], left[i]);
+            encodeSample(&raw[(i * 2 + 1) * sampleBytes], right[i]);
+        }
+        if (std::fwrite(raw.data(), 1, raw.size(), file) != raw.size()) fail("write failed");
+        framesWritten += frames;
+    }
+
+    // Patch the RIFF and data sizes and close the file
+    void close() {
+        if (!file) return;
+        uint64_t dataBytes = framesWritten * 2 * bytesPerSample();
+        if (dataBytes + 36 > UINT32_MAX) fail("output exceeds the 4 GB RIFF limit");
+        writeHeader(static_cast<uint32_t>(dataBytes));
+        if (std::fclose(file) != 0) {
+            file = nullptr;
+            fail("close failed");
+        }
+        file = nullptr;
+    }
+
+    uint64_t getFramesWritten() const { return framesWritten; }
+};
@@ -0,0 +1,114 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Batch Scaling Benchmark
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Writes a synthetic catalog (mixed track lengths) to a scratch directory
+ * and masters it with 1, 2, 4, ... workers through the same scheduler and
+ * job path as `luvlang-master --batch`, printing throughput and parallel
+ * efficiency per worker count.
+ *
+ * Usage: benchmark_batch [files=16] [seconds=20] [max-workers=16] [io-jobs=2]
+ */
+
+#include "BatchScheduler.h"
+#include "MasteringJob.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static std::vector<std::string> writeCatalog(const fs::path& directory, int files, double seconds) {
+    fs::create_directories(directory);
+    std::vector<std::string> paths;
+    std::mt19937 random(1770);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+
+    const int sampleRate = 48000;
+    for (int f = 0; f < files; ++f) {
+        // Lengths spread 0.5x to 1.5x so the tail needs stealing to balance
+        const double length = seconds * (0.5 + static_cast<double>(f % 5) / 4.0);
+        const size_t frames = static_cast<size_t>(length * sampleRate);
+        const double frequency = 55.0 * (1 + f % 7);
+
+        std::string path = (directory / ("track_" + std::to_string(f) + ".wav")).string();
+        WavWriter writer(path, sampleRate, WavWriter::FLOAT_32);
+        std::vector<float> left(4096), right(4096);
+        for (size_t offset = 0; offset < frames; offset += left.size()) {
+            size_t count = std::min(left.size(), frames - offset);
+            for (size_t i = 0; i < count; ++i) {
+                double t = static_cast<double>(offset + i) / sampleRate;
+                float tone = static_cast<float>(0.3 * std::sin(2.0 * PI * frequency * t));
+                left[i] = tone + noise(random);
+                right[i] = 0.8f * tone + noise(random);
+            }
+            writer.write(left.data(), right.data(), count);
+        }
+        writer.close();
+        paths.push_back(path);
+    }
+    return paths;
+}
+
+int main(int argc, char** argv) {
+    const int files = argc > 1 ? std::atoi(argv[1]) : 16;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 20.0;
+    const int maxWorkers = argc > 3 ? std::atoi(argv[3]) : 16;
+    const int ioJobs = argc > 4 ? std::atoi(argv[4]) : 2;
+
+    const fs::path scratch = fs::temp_directory_path() / "luvlang_benchmark_batch";
+    std::printf("Writing %d synthetic tracks (~%.0f s each) to %s\n", files, seconds, scratch.string().c_str());
+    std::vector<std::string> inputs = writeCatalog(scratch / "in", files, seconds);
+    fs::create_directories(scratch / "out");
+
+    std::vector<uintmax_t> sizes;
+    for (const auto& path : inputs) sizes.push_back(fs::file_size(path));
+    std::vector<size_t> order(inputs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    PlatformPreset preset = getPlatformPreset("spotify", UserParams());
+    MasteringJobOptions options;
+    options.normalize = false;  // One pass per file: measures scheduling, not convergence
+
+    std::printf("Hardware threads: %u\n\n", std::thread::hardware_concurrency());
+    std::printf("%8s %10s %12s %9s %11s %7s\n", "workers", "wall (s)", "x realtime", "speedup", "efficiency", "steals");
+
+    double baseline = 0.0;
+    for (int workers = 1; workers <= maxWorkers; workers *= 2) {
+        std::vector<std::optional<MasteringJob::Engine>> engines(workers);
+        std::vector<MasteringJob> renderers(workers);
+        std::vector<double> durations(inputs.size(), 0.0);
+        std::atomic<int> failures{0};
+        IOGate io(ioJobs);
+
+        const auto start = std::chrono::steady_clock::now();
+        WorkStealingPool pool(workers);
+        pool.run(order, [&](int worker, size_t index) {
+            std::string output = (scratch / "out" / fs::path(inputs[index]).filename()).string();
+            MasteringJobResult result = renderers[worker].run(inputs[index], output, preset, options,
+                                                              engines[worker], &io);
+            if (!result.success) failures.fetch_add(1);
+            durations[index] = result.durationSeconds;
+        });
+        const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const double audio = std::accumulate(durations.begin(), durations.end(), 0.0);
+        if (workers == 1) baseline = wall;
+        const double speedup = baseline / wall;
+        std::printf("%8d %10.3f %12.1f %8.2fx %10.0f%% %7zu%s\n", workers, wall, audio / wall, speedup,
+                    100.0 * speedup / workers, pool.getStealCount(), failures.load() ? "  (failures)" : "");
+    }
+
+    fs::remove_all(scratch);
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Construction Benchmark
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Times heap construction + destruction of the oversamplers, the limiter
+ * tiers, the sample rate converter and whole engines, the way A/B
+ * comparison, reference preview and batch workers create them. The
+ * FIR, sinc and half-band tables are compile-time constants, so what is
+ * left is buffer allocation and the sample-rate-dependent filter designs.
+ *
+ * Usage: benchmark_construction [instances=2000]
+ */
+
+#include "MasteringEngine.h"
+#include "SampleRateConverter.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+template <typename T>
+static void timeConstruction(const char* name, int instances) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < instances; ++i) {
+        auto instance = std::make_unique<T>();
+        asm volatile("" : : "r"(instance.get()) : "memory");  // Keep the construction
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-36s %10.2f\n", name, seconds / instances * 1e6);
+}
+
+int main(int argc, char** argv) {
+    const int instances = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    std::printf("Construction + destruction, mean of %d instances\n\n", instances);
+    std::printf("%-36s %10s\n", "object", "us");
+    timeConstruction<Oversampler<double, 2, 32>>("Oversampler 2x / 32 taps", instances);
+    timeConstruction<Oversampler<double, 4, 64>>("Oversampler 4x / 64 taps", instances);
+    timeConstruction<Oversampler<double, 8, 128>>("Oversampler 8x / 128 taps", instances);
+    timeConstruction<HalfBandOversampler<double, 8>>("HalfBandOversampler 8x", instances);
+    timeConstruction<TruePeakLimiter<double, RealtimePreviewQuality>>("TruePeakLimiter realtime preview", instances);
+    timeConstruction<TruePeakLimiter<double, StandardQuality>>("TruePeakLimiter standard", instances);
+    timeConstruction<TruePeakLimiter<double, ExportQuality>>("TruePeakLimiter export", instances);
+    timeConstruction<SampleRateConverter>("SampleRateConverter", instances);
+    timeConstruction<MasteringEnginePreview>("MasteringEnginePreview", instances);
+    timeConstruction<MasteringEngine>("MasteringEngine", instances);
+    timeConstruction<MasteringEngineExport>("MasteringEngineExport", instances);
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - CPU Dispatch Benchmark
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Times every kernel in each CpuDispatch.h variant this CPU can run (dB
+ * conversions, flat-TPDF quantiser, FIR up/downsampling per quality tier),
+ * then the full true-peak limiter with its oversamplers built under each
+ * variant. Kernels report millions of samples (or frames) per second, the
+ * limiter ns per stereo frame.
+ *
+ * Usage: benchmark_dispatch [millions=20]
+ */
+
+#include "CpuDispatch.h"
+#include "TruePeakLimiter.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+static double timeIt(const std::function<void()>& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double sink = 0.0;
+
+// Millions of samples per second through a 512-sample block kernel
+template <typename Sample, typename Kernel>
+static double gainThroughput(Kernel kernel, int count, double minValue, double maxValue) {
+    const int block = 512;
+    std::mt19937 random(1770);
+    std::uniform_real_distribution<double> dist(minValue, maxValue);
+    std::vector<Sample> input(block), output(block);
+    for (auto& x : input) x = static_cast<Sample>(dist(random));
+    const int passes = count / block;
+    double seconds = timeIt([&] {
+        for (int p = 0; p < passes; ++p) {
+            kernel(input.data(), output.data(), block);
+            sink += output[p % block];
+        }
+    });
+    return passes * block / seconds / 1e6;
+}
+
+static double ditherThroughput(const DSPKernelTable& table, int count) {
+    const int block = 512;
+    std::mt19937 random(1771);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> input(block), samples(block), tpdf(block);
+    for (int i = 0; i < block; ++i) {
+        input[i] = dist(random);
+        tpdf[i] = dist(random);
+    }
+    const int passes = count / block;
+    double seconds = timeIt([&] {
+        for (int p = 0; p < passes; ++p) {
+            samples = input;
+            table.ditherQuantizeF64(samples.data(), tpdf.data(), block, 32767.0, 1.0 / 32767.0);
+            sink += samples[p % block];
+        }
+    });
+    return passes * block / seconds / 1e6;
+}
+
+// Millions of base-rate frames per second through one FIR kernel
+static double firThroughput(FIRKernelF64 kernel, int tapCount, int outputs, int count) {
+    const int frames = 1024;
+    std::mt19937 random(1772);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> history(2 * (tapCount + frames)), taps(2 * tapCount), output(2 * outputs);
+    for (auto& x : history) x = dist(random);
+    for (int j = 0; j < tapCount; ++j) taps[2 * j] = taps[2 * j + 1] = dist(random);
+    const int passes = count / frames;
+    double seconds = timeIt([&] {
+        for (int p = 0; p < passes; ++p) {
+            for (int f = 0; f < frames; ++f) {
+                kernel(history.data() + 2 * f, taps.data(), output.data());
+            }
+            sink += output[0];
+        }
+    });
+    return passes * frames / seconds / 1e6;
+}
+
+template <typename Quality>
+static double limiterNsPerFrame(int frames) {
+    auto limiter = std::make_unique<TruePeakLimiter<double, Quality>>();
+    limiter->setSampleRate(48000.0);
+    limiter->setThreshold(-6.0);
+    std::vector<double> left(frames), right(frames);
+    for (int i = 0; i < frames; ++i) {
+        left[i] = 1.5 * std::sin(0.13 * i);
+        right[i] = 1.2 * std::sin(0.071 * i);
+    }
+    double seconds = timeIt([&] { limiter->processBlock(left.data(), right.data(), frames); });
+    sink += left[frames / 2];
+    return seconds / frames * 1e9;
+}
+
+int main(int argc, char** argv) {
+    const int count = static_cast<int>((argc > 1 ? std::atof(argv[1]) : 20.0) * 1e6);
+
+    std::printf("Detected: %s, active: %s\n\n", cpuIsaName(detectCpuIsa()), dspKernels().name);
+    std::printf("%-24s", "Msamples/s");
+    for (int isa = 0; isa < CPU_ISA_COUNT; ++isa) {
+        std::printf(" %10s", cpuIsaName(static_cast<CpuIsa>(isa)));
+    }
+    std::printf("\n");
+
+    auto row = [&](const char* name, const std::function<double(const DSPKernelTable&)>& measure) {
+        std::printf("%-24s", name);
+        for (int isa = 0; isa < CPU_ISA_COUNT; ++isa) {
+            const DSPKernelTable* table = dspKernelVariant(static_cast<CpuIsa>(isa));
+            if (table) {
+                std::printf(" %10.1f", measure(*table));
+            } else {
+                std::printf(" %10s", "-");
+            }
+        }
+        std::printf("\n");
+    };
+
+    row("lin -> dB double", [&](const DSPKernelTable& t) { return gainThroughput<double>(t.linearToDbF64, count, 1e-6, 4.0); });
+    row("lin -> dB float", [&](const DSPKernelTable& t) { return gainThroughput<float>(t.linearToDbF32, count, 1e-6, 4.0); });
+    row("dB -> lin double", [&](const DSPKernelTable& t) { return gainThroughput<double>(t.dbToLinearF64, count, -120.0, 24.0); });
+    row("dB -> lin float", [&](const DSPKernelTable& t) { return gainThroughput<float>(t.dbToLinearF32, count, -120.0, 24.0); });
+    row("dither quantize", [&](const DSPKernelTable& t) { return ditherThroughput(t, count); });
+    for (int index = 0; index < 3; ++index) {
+        const int factor = 2 << index;
+        char name[32];
+        std::snprintf(name, sizeof(name), "FIR up %dx (frames)", factor);
+        row(name, [&](const DSPKernelTable& t) {
+            return firThroughput(t.firUpsampleF64[index], 16 * factor, factor, count / factor);
+        });
+        std::snprintf(name, sizeof(name), "FIR down %dx (frames)", factor);
+        row(name, [&](const DSPKernelTable& t) {
+            return firThroughput(t.firDownsampleF64[index], 16 * factor, 1, count / factor);
+        });
+    }
+
+    std::printf("\n%-24s", "limiter ns/frame");
+    for (int isa = 0; isa < CPU_ISA_COUNT; ++isa) {
+        std::printf(" %10s", cpuIsaName(static_cast<CpuIsa>(isa)));
+    }
+    std::printf("\n");
+    const int frames = count / 40;
+    auto limiterRow = [&](const char* name, double (*measure)(int)) {
+        std::printf("%-24s", name);
+        for (int isa = 0; isa < CPU_ISA_COUNT; ++isa) {
+            if (selectDSPKernels(static_cast<CpuIsa>(isa))) {
+                std::printf(" %10.1f", measure(frames));
+            } else {
+                std::printf(" %10s", "-");
+            }
+        }
+        std::printf("\n");
+    };
+    limiterRow("realtime preview (2x)", limiterNsPerFrame<RealtimePreviewQuality>);
+    limiterRow("standard (4x)", limiterNsPerFrame<StandardQuality>);
+    limiterRow("export (8x)", limiterNsPerFrame<ExportQuality>);
+
+    return sink == 12345.678 ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Fast dB Conversion Benchmark
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Times the FastMath.h block kernels against libm (linearToDb / dbToLinear
+ * from DSPCommon.h) in double and float, then reports the worst conversion
+ * error per 12 dB band across -120..+24 dB: linear -> dB against log10, and
+ * dB -> linear measured back through log10.
+ *
+ * Usage: benchmark_fastmath [millions=50]
+ */
+
+#include "DSPCommon.h"
+#include "FastMath.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+static double timeIt(const std::function<void()>& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Sample>
+static double timeConversions(const char* name, int count, double& sink) {
+    const int block = 512;
+    std::mt19937 random(1770);
+    std::uniform_real_distribution<double> dB(-120.0, 24.0);
+    std::vector<Sample> levels(block), gains(block), output(block);
+    for (int i = 0; i < block; ++i) {
+        gains[i] = static_cast<Sample>(dB(random));
+        levels[i] = static_cast<Sample>(dbToLinear(static_cast<double>(gains[i])));
+    }
+    const int passes = count / block;
+
+    double libmToDb = timeIt([&] {
+        for (int p = 0; p < passes; ++p) {
+            for (int i = 0; i < block; ++i) output[i] = linearToDb(levels[i]);
+            sink += output[p % block];
+        }
+    });
+    double fastToDb = timeIt([&] {
+        for (int p = 0; p < passes; ++p) {
+            linearToDbBlock(levels.data(), output.data(), block);
+            sink += output[p % block];
+        }
+    });
+    double libmToLinear = timeIt([&] {
+        for (int p = 0; p < passes; ++p) {
+            for (int i = 0; i < block; ++i) output[i] = dbToLinear(gains[i]);
+            sink += output[p % block];
+        }
+    });
+    double fastToLinear = timeIt([&] {
+        for (int p = 0; p < passes; ++p) {
+            dbToLinearBlock(gains.data(), output.data(), block);
+            sink += output[p % block];
+        }
+    });
+
+    const double millions = passes * block / 1e6;
+    std::printf("%-8s %-10s %10.1f %10.1f %9.1fx\n", name, "lin -> dB",
+                millions / libmToDb, millions / fastToDb, libmToDb / fastToDb);
+    std::printf("%-8s %-10s %10.1f %10.1f %9.1fx\n", name, "dB -> lin",
+                millions / libmToLinear, millions / fastToLinear, libmToLinear / fastToLinear);
+    return sink;
+}
+
+// Worst error in dB over [low, low + 12) dB, 100k points
+template <typename Sample>
+static void bandError(double low, double& toDbError, double& toLinearError) {
+    const int points = 100000;
+    toDbError = 0.0;
+    toLinearError = 0.0;
+    for (int i = 0; i < points; ++i) {
+        Sample gainDB = static_cast<Sample>(low + 12.0 * i / points);
+        Sample linear = static_cast<Sample>(std::pow(10.0, gainDB / 20.0));
+        double exactDB = 20.0 * std::log10(static_cast<double>(linear));
+        toDbError = std::max(toDbError, std::abs(fastLinearToDb(linear) - exactDB));
+        double roundTrip = 20.0 * std::log10(static_cast<double>(fastDbToLinear(gainDB)));
+        toLinearError = std::max(toLinearError, std::abs(roundTrip - gainDB));
+    }
+}
+
+int main(int argc, char** argv) {
+    const double millions = argc > 1 ? std::atof(argv[1]) : 50.0;
+    const int count = static_cast<int>(millions * 1e6);
+    double sink = 0.0;
+
+    std::printf("%.0f M conversions, 512-sample blocks (M conversions / s)\n\n", millions);
+    std::printf("%-8s %-10s %10s %10s %10s\n", "type", "direction", "libm", "fast", "speedup");
+    timeConversions<double>("double", count, sink);
+    timeConversions<float>("float", count, sink);
+
+    std::printf("\nWorst error (dB) per band, target 0.001\n");
+    std::printf("%-16s %12s %12s %12s %12s\n", "band (dB)", "f64 lin->dB", "f64 dB->lin", "f32 lin->dB", "f32 dB->lin");
+    for (double low = -120.0; low < 24.0; low += 12.0) {
+        double d1, d2, f1, f2;
+        bandError<double>(low, d1, d2);
+        bandError<float>(low, f1, f2);
+        std::printf("%6.0f .. %6.0f %12.2e %12.2e %12.2e %12.2e\n", low, low + 12.0, d1, d2, f1, f2);
+    }
+
+    std::printf("\n(checksum %.3f)\n", sink);
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Stereo Filter Benchmark
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Times a pair of mono ZDFBiquads against one StereoZDFBiquad (SIMD lane
+ * pair) on the filter shapes the chain actually runs: a single biquad, the
+ * 7-band EQ cascade with fixed gains, and the 3-band LR4 crossover. Then
+ * the SevenBandEQ coefficient engine against a full per-sample redesign of
+ * every band, with gains steady and with gains moving every block.
+ *
+ * Usage: benchmark_filters [seconds=60]
+ */
+
+#include "Crossover.h"
+#include "Equalizer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+static double timeIt(const std::function<void()>& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char* name, double mono, double stereo, double seconds) {
+    std::printf("%-14s %10.3f %10.3f %9.2fx %10.0fx\n", name, mono, stereo, mono / stereo, seconds / stereo);
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 60.0;
+    const int frames = static_cast<int>(seconds * 48000.0);
+    const int block = 512;
+
+    std::mt19937 random(1770);
+    std::uniform_real_distribution<double> noise(-0.5, 0.5);
+    std::vector<double> left(frames), right(frames);
+    for (int i = 0; i < frames; ++i) {
+        left[i] = noise(random);
+        right[i] = noise(random);
+    }
+    double sink = 0.0;
+
+#if defined(LUVLANG_SIMD_WASM)
+    const char* lanes = "wasm simd128";
+#elif defined(LUVLANG_SIMD_SSE2)
+    const char* lanes = "SSE2";
+#elif defined(LUVLANG_SIMD_NEON)
+    const char* lanes = "NEON";
+#else
+    const char* lanes = "scalar";
+#endif
+    std::printf("%.0f s stereo @ 48 kHz, Double2 = %s\n\n", seconds, lanes);
+    std::printf("%-14s %10s %10s %10s %11s\n", "filter", "mono x2", "stereo", "speedup", "x realtime");
+
+    // Single biquad
+    {
+        ZDFBiquad<double> monoL, monoR;
+        StereoZDFBiquad<double> stereo;
+        monoL.setCoefficients(1000.0, 0.707, 3.0, ZDFDesign::BELL);
+        monoR.setCoefficients(1000.0, 0.707, 3.0, ZDFDesign::BELL);
+        stereo.setCoefficients(1000.0, 0.707, 3.0, ZDFDesign::BELL);
+        double mono = timeIt([&] {
+            for (int i = 0; i < frames; ++i) sink += monoL.process(left[i]) + monoR.process(right[i]);
+        });
+        double pair = timeIt([&] {
+            for (int i = 0; i < frames; ++i) {
+                Double2 y = stereo.process(Double2(left[i], right[i]));
+                sink += y.left() + y.right();
+            }
+        });
+        report("biquad", mono, pair, seconds);
+    }
+
+    // 7-band cascade, fixed coefficients
+    {
+        const double freqs[7] = {40.0, 120.0, 350.0, 1000.0, 3500.0, 8000.0, 14000.0};
+        ZDFBiquad<double> monoL[7], monoR[7];
+        StereoZDFBiquad<double> stereo[7];
+        for (int b = 0; b < 7; ++b) {
+            monoL[b].setCoefficients(freqs[b], 0.707, 1.5, ZDFDesign::BELL);
+            monoR[b].setCoefficients(freqs[b], 0.707, 1.5, ZDFDesign::BELL);
+            stereo[b].setCoefficients(freqs[b], 0.707, 1.5, ZDFDesign::BELL);
+        }
+        std::vector<double> l = left, r = right;
+        double mono = timeIt([&] {
+            for (int offset = 0; offset + block <= frames; offset += block) {
+                for (int b = 0; b < 7; ++b) {
+                    monoL[b].processBlock(l.data() + offset, block);
+                    monoR[b].processBlock(r.data() + offset, block);
+                }
+            }
+        });
+        l = left;
+        r = right;
+        double pair = timeIt([&] {
+            for (int offset = 0; offset + block <= frames; offset += block) {
+                for (int b = 0; b < 7; ++b) stereo[b].processBlock(l.data() + offset, r.data() + offset, block);
+            }
+        });
+        sink += l[frames / 2];
+        report("7-band EQ", mono, pair, seconds);
+    }
+
+    // 3-band LR4 crossover (8 biquads per channel)
+    {
+        ThreeBandCrossover<double> crossover;
+        ZDFBiquad<double> lp1[2][2], lp2[2][2], hp1[2][2], hp2[2][2];  // [split][channel]
+        const double splits[2] = {250.0, 2000.0};
+        for (int s = 0; s < 2; ++s) {
+            for (int c = 0; c < 2; ++c) {
+                lp1[s][c].setCoefficients(splits[s], 0.707, 0.0, ZDFDesign::LOWPASS);
+                lp2[s][c].setCoefficients(splits[s], 0.707, 0.0, ZDFDesign::LOWPASS);
+                hp1[s][c].setCoefficients(splits[s], 0.707, 0.0, ZDFDesign::HIGHPASS);
+                hp2[s][c].setCoefficients(splits[s], 0.707, 0.0, ZDFDesign::HIGHPASS);
+            }
+        }
+        double mono = timeIt([&] {
+            for (int i = 0; i < frames; ++i) {
+                const double input[2] = {left[i], right[i]};
+                for (int c = 0; c < 2; ++c) {
+                    double low = lp2[0][c].process(lp1[0][c].process(input[c]));
+                    double midHigh = hp2[0][c].process(hp1[0][c].process(input[c]));
+                    double mid = lp2[1][c].process(lp1[1][c].process(midHigh));
+                    double high = hp2[1][c].process(hp1[1][c].process(midHigh));
+                    sink += low + mid + high;
+                }
+            }
+        });
+        double pair = timeIt([&] {
+            for (int i = 0; i < frames; ++i) {
+                Double2 low, mid, high;
+                crossover.process(Double2(left[i], right[i]), low, mid, high);
+                Double2 sum = low + mid + high;
+                sink += sum.left() + sum.right();
+            }
+        });
+        report("LR4 3-band", mono, pair, seconds);
+    }
+
+    // Smoothed EQ: per-sample redesign (tan + pow per band) vs SevenBandEQ
+    std::printf("\n%-14s %10s %10s %10s %11s\n", "smoothed EQ", "redesign", "engine", "speedup", "x realtime");
+    const double freqs[7] = {40.0, 120.0, 350.0, 1000.0, 3500.0, 8000.0, 14000.0};
+    for (int moving = 0; moving < 2; ++moving) {
+        StereoZDFBiquad<double> redesign[7];
+        ParameterSmoother smoothers[7];
+        SevenBandEQ<double> eq;
+        std::vector<double> l = left, r = right;
+
+        double full = timeIt([&] {
+            for (int offset = 0; offset + block <= frames; offset += block) {
+                for (int b = 0; b < 7; ++b) {
+                    if (moving) smoothers[b].setTarget((offset / block) % 2 ? 3.0 : -3.0);
+                    for (int i = offset; i < offset + block; ++i) {
+                        redesign[b].setCoefficients(freqs[b], 0.707, smoothers[b].getSmoothed(), ZDFDesign::BELL);
+                        Double2 y = redesign[b].process(Double2(l[i], r[i]));
+                        l[i] = y.left();
+                        r[i] = y.right();
+                    }
+                }
+            }
+        });
+        sink += l[frames / 2];
+        l = left;
+        r = right;
+        double engine = timeIt([&] {
+            for (int offset = 0; offset + block <= frames; offset += block) {
+                if (moving) {
+                    for (int b = 0; b < 7; ++b) eq.setBandGain(b, (offset / block) % 2 ? 3.0 : -3.0);
+                }
+                eq.processBlock(l.data() + offset, r.data() + offset, block);
+            }
+        });
+        sink += l[frames / 2];
+        report(moving ? "gains moving" : "gains steady", full, engine, seconds);
+    }
+
+    std::printf("\n(checksum %.3f)\n", sink);
+    return 0;
+}
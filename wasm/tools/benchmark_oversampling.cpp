@@ -0,0 +1,146 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Oversampling Tier Benchmark
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * One row per true-peak quality tier (plus plain 1x sample peak), then the
+ * half-band IIR cascade at each factor:
+ *   - cost: TruePeakLimiter throughput on stereo noise, double and float
+ *   - true-peak detection error: every one-period window of full-scale sines
+ *     swept 1-20 kHz (true peak 0 dBTP), worst-case and mean error in dB
+ *   - latency of the oversampling filters in samples (the half-band group
+ *     delay is fractional; the engine reports it rounded)
+ *
+ * Usage: benchmark_oversampling [seconds=20]
+ */
+
+#include "TruePeakLimiter.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct SamplePeakQuality : OversamplingQuality<1, 1> {
+    constexpr static const char* NAME = "sample peak";
+};
+
+constexpr double SAMPLE_RATE = 48000.0;
+
+template <typename Sample, typename Quality>
+static double limiterSeconds(const std::vector<double>& noiseL, const std::vector<double>& noiseR,
+                             OversamplingFilter filter) {
+    const int frames = static_cast<int>(noiseL.size());
+    std::vector<Sample> left(noiseL.begin(), noiseL.end()), right(noiseR.begin(), noiseR.end());
+    TruePeakLimiter<Sample, Quality> limiter(SAMPLE_RATE);
+    limiter.setThreshold(-1.0);
+    limiter.setOversamplingFilter(filter);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int offset = 0; offset < frames; offset += 512) {
+        limiter.processBlock(left.data() + offset, right.data() + offset, std::min(512, frames - offset));
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// A sine's continuous peak inside any window of one period is exactly its
+// amplitude, so every one-period window of a full-scale tone should read
+// 0 dBTP. Reports the worst and mean under-read over all windows of
+// 1-20 kHz tones at random phases.
+template <typename Over>
+static void detectionError(double& worstDB, double& meanDB) {
+    using Pair = typename Over::Pair;
+    const int tones = 200;
+    const int settle = 256;
+    const int frames = 2400;
+    std::mt19937 random(1770);
+    std::uniform_real_distribution<double> phase(0.0, 2.0 * PI);
+
+    worstDB = 0.0;
+    meanDB = 0.0;
+    int windows = 0;
+    for (int t = 0; t < tones; ++t) {
+        double freq = 1000.0 * std::pow(20.0, t / (tones - 1.0));  // 1 kHz .. 20 kHz
+        double start = phase(random);
+        Over oversampler;
+        typename Over::Frame up;
+        std::vector<double> framePeak(frames);
+        for (int i = 0; i < frames; ++i) {
+            double x = std::sin(2.0 * PI * freq * i / SAMPLE_RATE + start);
+            oversampler.upsample(Pair(x, x), up);
+            framePeak[i] = 0.0;
+            for (const Pair& value : up) {
+                framePeak[i] = std::max(framePeak[i], std::abs(value.left()));
+            }
+        }
+
+        // Each frame covers the interval since the previous one, so a window
+        // of ceil(period) + 1 frames spans at least one full period
+        const int length = static_cast<int>(std::ceil(SAMPLE_RATE / freq)) + 1;
+        for (int i = settle; i + length <= frames; ++i) {
+            double peak = 0.0;
+            for (int j = i; j < i + length; ++j) {
+                peak = std::max(peak, framePeak[j]);
+            }
+            double errorDB = std::abs(linearToDb(peak));
+            worstDB = std::max(worstDB, errorDB);
+            meanDB += errorDB;
+            ++windows;
+        }
+    }
+    meanDB /= windows;
+}
+
+template <typename Quality>
+static void row(const std::vector<double>& noiseL, const std::vector<double>& noiseR, double seconds) {
+    using Over = Oversampler<double, Quality::FACTOR, Quality::TAP_COUNT>;
+    double doubleSeconds = limiterSeconds<double, Quality>(noiseL, noiseR, OVERSAMPLING_LINEAR_PHASE_FIR);
+    double floatSeconds = limiterSeconds<float, Quality>(noiseL, noiseR, OVERSAMPLING_LINEAR_PHASE_FIR);
+    double worstDB, meanDB;
+    detectionError<Over>(worstDB, meanDB);
+    std::printf("%-18s %3dx %5d %9.1f %9.1f %11.2f %10.3f %8.2f\n",
+                Quality::NAME, Quality::FACTOR, Quality::TAP_COUNT,
+                seconds / doubleSeconds, seconds / floatSeconds, worstDB, meanDB,
+                static_cast<double>(Over::LATENCY_SAMPLES));
+}
+
+// Same factor as the tier, half-band IIR cascade instead of its FIR
+template <typename Quality>
+static void halfBandRow(const std::vector<double>& noiseL, const std::vector<double>& noiseR, double seconds) {
+    using Over = HalfBandOversampler<double, Quality::FACTOR>;
+    double doubleSeconds = limiterSeconds<double, Quality>(noiseL, noiseR, OVERSAMPLING_HALF_BAND_IIR);
+    double floatSeconds = limiterSeconds<float, Quality>(noiseL, noiseR, OVERSAMPLING_HALF_BAND_IIR);
+    double worstDB, meanDB;
+    detectionError<Over>(worstDB, meanDB);
+    std::printf("%-18s %3dx %5s %9.1f %9.1f %11.2f %10.3f %8.2f\n",
+                "half-band IIR", Quality::FACTOR, "-",
+                seconds / doubleSeconds, seconds / floatSeconds, worstDB, meanDB,
+                Over().getGroupDelay());
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 20.0;
+    const int frames = static_cast<int>(seconds * SAMPLE_RATE);
+
+    std::vector<double> noiseL(frames), noiseR(frames);
+    std::mt19937 random(42);
+    std::normal_distribution<double> noise(0.0, 0.3);
+    for (int i = 0; i < frames; ++i) {
+        noiseL[i] = noise(random);
+        noiseR[i] = noise(random);
+    }
+
+    std::printf("TruePeakLimiter, %.0f s stereo @ 48 kHz; detection error over 1-20 kHz sines\n\n", seconds);
+    std::printf("%-18s %4s %5s %9s %9s %11s %10s %8s\n",
+                "tier", "os", "taps", "x rt f64", "x rt f32", "worst (dB)", "mean (dB)", "latency");
+    row<SamplePeakQuality>(noiseL, noiseR, seconds);
+    row<RealtimePreviewQuality>(noiseL, noiseR, seconds);
+    row<StandardQuality>(noiseL, noiseR, seconds);
+    row<ExportQuality>(noiseL, noiseR, seconds);
+    halfBandRow<RealtimePreviewQuality>(noiseL, noiseR, seconds);
+    halfBandRow<StandardQuality>(noiseL, noiseR, seconds);
+    halfBandRow<ExportQuality>(noiseL, noiseR, seconds);
+    return 0;
+}
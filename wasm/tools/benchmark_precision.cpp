@@ -0,0 +1,90 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * LuvLang - Precision Benchmark
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Renders the same programme through the double reference chain and the
+ * float32 chain (MasteringEngineF32), then reports throughput for both and
+ * the null-test residual (float output minus double output) in dBFS.
+ * Dithering is off so the residual is the precision difference alone.
+ *
+ * Usage: benchmark_precision [seconds=30] [block=512]
+ */
+
+#include "MasteringEngine.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+template <typename Engine>
+static void configure(Engine& engine) {
+    engine.setAllEQGains({1.5, 0.0, -1.0, 0.0, 1.0, 0.5, 2.0});
+    engine.setDeEsserEnabled(true);
+    engine.setMultibandEnabled(true);
+    engine.setStereoWidth(1.2);
+    engine.setSaturationDrive(1.5);
+    engine.setSaturationMix(0.2);
+    engine.setLimiterThreshold(-1.0);
+}
+
+template <typename Engine>
+static double render(std::vector<float>& left, std::vector<float>& right, int blockSize, double& integratedLUFS) {
+    const int frames = static_cast<int>(left.size());
+    Engine engine(48000.0);
+    configure(engine);
+    auto start = std::chrono::steady_clock::now();
+    for (int offset = 0; offset < frames; offset += blockSize) {
+        engine.processPlanar(left.data() + offset, right.data() + offset,
+                             std::min(blockSize, frames - offset));
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    integratedLUFS = engine.getIntegratedLUFS();
+    return elapsed;
+}
+
+int main(int argc, char** argv) {
+    const double seconds = argc > 1 ? std::atof(argv[1]) : 30.0;
+    const int blockSize = argc > 2 ? std::atoi(argv[2]) : 512;
+    const double sampleRate = 48000.0;
+    const int frames = static_cast<int>(seconds * sampleRate);
+
+    std::vector<float> inputL(frames), inputR(frames);
+    std::mt19937 random(1770);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    for (int i = 0; i < frames; ++i) {
+        float tone = static_cast<float>(0.4 * std::sin(2.0 * PI * 110.0 * i / sampleRate));
+        inputL[i] = tone + noise(random);
+        inputR[i] = 0.9f * tone + noise(random);
+    }
+
+    double doubleLUFS = 0.0, floatLUFS = 0.0;
+    std::vector<float> doubleL = inputL, doubleR = inputR;
+    const double doubleSeconds = render<MasteringEngine>(doubleL, doubleR, blockSize, doubleLUFS);
+    std::vector<float> floatL = inputL, floatR = inputR;
+    const double floatSeconds = render<MasteringEngineF32>(floatL, floatR, blockSize, floatLUFS);
+
+    // Skip the first second: both chains start from the same state, but the
+    // residual of interest is the steady-state one
+    double maxResidual = 0.0, residualEnergy = 0.0;
+    const int skip = std::min(frames, static_cast<int>(sampleRate));
+    for (int i = skip; i < frames; ++i) {
+        double dL = static_cast<double>(floatL[i]) - doubleL[i];
+        double dR = static_cast<double>(floatR[i]) - doubleR[i];
+        maxResidual = std::max(maxResidual, std::max(std::abs(dL), std::abs(dR)));
+        residualEnergy += dL * dL + dR * dR;
+    }
+    const double rmsResidual = std::sqrt(residualEnergy / std::max(1, 2 * (frames - skip)));
+
+    std::printf("Full chain, %.0f s stereo @ 48 kHz, block %d, dither off\n\n", seconds, blockSize);
+    std::printf("%-10s %10s %12s %14s\n", "precision", "time (s)", "x realtime", "integrated");
+    std::printf("%-10s %10.3f %12.1f %10.2f LUFS\n", "double", doubleSeconds, seconds / doubleSeconds, doubleLUFS);
+    std::printf("%-10s %10.3f %12.1f %10.2f LUFS\n", "float", floatSeconds, seconds / floatSeconds, floatLUFS);
+    std::printf("\nSpeedup: %.2fx\n", doubleSeconds / floatSeconds);
+    std::printf("Null residual: peak %.1f dBFS, RMS %.1f dBFS\n",
+                linearToDb(std::max(maxResidual, 1e-15)), linearToDb(std::max(rmsResidual, 1e-15)));
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+ * ═══════════════════════════════════════════════════════════════════════════
+ * luvlang-master - Native Command-Line Mastering Renderer
+ * ═══════════════════════════════════════════════════════════════════════════
+ *
+ * Streams a WAV file through the same MasteringEngine chain the browser runs,
+ * in fixed-size blocks, with constant memory regardless of file length. The
+ * server renders at the export tier (8x true-peak oversampling, 128 taps).
+ *
+ * Loudness normalization is multi-pass (the Python engine uses a dual-pass
+ * ffmpeg loudnorm): each pass renders and measures integrated LUFS, and the
+ * next re-renders with a corrected input trim until the programme lands
+ * within 0.3 LU of the platform target (or --max-passes is reached).
+ *
+ * Batch mode (--batch OUTPUT_DIR) masters a whole catalog with the same
+ * settings: files are scheduled largest-first onto a work-stealing pool of
+ * --jobs workers, each owning one engine, with at most --io-jobs of them
+ * reading or writing at once. Each output is OUTPUT_DIR/<input file name>;
+ * a batch where two inputs share a file name, or an output would replace
+ * an input, is rejected before anything renders.
+ *
+ * Usage:
+ *   luvlang-master input.wav output.wav [--platform spotify] [--preset p.json]
+ *       [--loudness LUFS] [--bass dB] [--mids dB] [--highs dB] [--width %]
+ *       [--compression 1-10] [--warmth %] [--bits 16|24|32] [--block N]
+ *       [--max-passes N] [--no-normalize] [--noise-shaping flat|f-weighted|high-pass]
+ *       [--lookahead ms]
+ *   luvlang-master --batch OUTPUT_DIR in1.wav in2.wav ... [--jobs N] [--io-jobs N] [...]
+ *
+ * The output is latency-compensated: the engine's delay is trimmed from the
+ * start and its tail flushed, so output sample n lines up with input sample n.
+ *
+ * Progress goes to stderr; a JSON result line per file goes to stdout
+ * (same keys as master_audio_ultimate.py, plus the measured values), and
+ * batch mode ends with a summary line.
+ */
+
+#include "BatchScheduler.h"
+#include "MasteringJob.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<std::string> inputFiles;
+    std::string outputFile;         // Single-file mode
+    std::string batchDirectory;     // Batch mode
+    std::string platform;
+    std::string presetFile;
+    UserParams flags;
+    MasteringJobOptions job;
+    int jobs = 0;                   // 0 = hardware concurrency
+    int ioJobs = 2;
+};
+
+void printUsage() {
+    std::fprintf(stderr,
+        "usage: luvlang-master input.wav output.wav [--platform NAME] [--preset FILE.json]\n"
+        "                      [--loudness LUFS] [--bass dB] [--mids dB] [--highs dB]\n"
+        "                      [--width %%] [--compression 1-10] [--warmth %%]\n"
+        "                      [--bits 16|24|32] [--block N] [--max-passes N] [--no-normalize]\n"
+        "                      [--noise-shaping flat|f-weighted|high-pass] [--lookahead ms]\n"
+        "       luvlang-master --batch OUTPUT_DIR in1.wav in2.wav ... [--jobs N] [--io-jobs N] [...]\n"
+        "platforms: spotify apple youtube tidal soundcloud deezer amazon pandora radio\n");
+}
+
+double parseNumberArg(const std::string& flag, const char* value) {
+    char* end = nullptr;
+    double number = std::strtod(value, &end);
+    if (end == value || *end != '\0') throw std::runtime_error(flag + " expects a number");
+    return number;
+}
+
+Options parseArguments(int argc, char** argv) {
+    Options options;
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--no-normalize") {
+            options.job.normalize = false;
+            continue;
+        }
+        if (arg.rfind("--", 0) != 0) {
+            positional.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) throw std::runtime_error(arg + " expects a value");
+        const char* value = argv[++i];
+
+        if (arg == "--platform") {
+            options.platform = value;
+        } else if (arg == "--preset") {
+            options.presetFile = value;
+        } else if (arg == "--batch") {
+            options.batchDirectory = value;
+        } else if (arg == "--jobs") {
+            options.jobs = static_cast<int>(parseNumberArg(arg, value));
+            if (options.jobs < 1) throw std::runtime_error("--jobs must be at least 1");
+        } else if (arg == "--io-jobs") {
+            options.ioJobs = static_cast<int>(parseNumberArg(arg, value));
+            if (options.ioJobs < 1) throw std::runtime_error("--io-jobs must be at least 1");
+        } else if (arg == "--bits") {
+            options.job.bits = static_cast<int>(parseNumberArg(arg, value));
+            if (options.job.bits != 16 && options.job.bits != 24 && options.job.bits != 32) {
+                throw std::runtime_error("--bits must be 16, 24 or 32");
+            }
+        } else if (arg == "--noise-shaping") {
+            std::string mode = value;
+            if (mode == "flat") options.job.noiseShaping = NOISE_SHAPING_FLAT;
+            else if (mode == "f-weighted") options.job.noiseShaping = NOISE_SHAPING_F_WEIGHTED;
+            else if (mode == "high-pass") options.job.noiseShaping = NOISE_SHAPING_HIGH_PASS;
+            else throw std::runtime_error("--noise-shaping must be flat, f-weighted or high-pass");
+        } else if (arg == "--lookahead") {
+            options.job.lookAheadMs = parseNumberArg(arg, value);
+            if (options.job.lookAheadMs < 0.0 || options.job.lookAheadMs > MAX_LOOKAHEAD_MS) {
+                throw std::runtime_error("--lookahead must be between 0 and 50 ms");
+            }
+        } else if (arg == "--max-passes") {
+            options.job.maxPasses = std::max(1, static_cast<int>(parseNumberArg(arg, value)));
+        } else if (arg == "--block") {
+            options.job.blockSize = static_cast<int>(parseNumberArg(arg, value));
+            if (options.job.blockSize < 1 || options.job.blockSize > 4096) {
+                throw std::runtime_error("--block must be between 1 and 4096");
+            }
+        } else if (arg == "--loudness" || arg == "--bass" || arg == "--mids" || arg == "--highs" ||
+                   arg == "--width" || arg == "--compression" || arg == "--warmth") {
+            options.flags.numbers[arg.substr(2)] = parseNumberArg(arg, value);
+        } else {
+            throw std::runtime_error("unknown option " + arg);
+        }
+    }
+
+    if (!options.batchDirectory.empty()) {
+        if (positional.empty()) throw std::runtime_error("--batch expects at least one input file");
+        options.inputFiles = positional;
+        return options;
+    }
+
+    if (positional.size() != 2) throw std::runtime_error("expected an input and an output file");
+    options.inputFiles = {positional[0]};
+    options.outputFile = positional[1];
+    return options;
+}
+
+UserParams loadPresetFile(const std::string& path) {
+    std::ifstream stream(path);
+    if (!stream) throw std::runtime_error(path + ": cannot open preset");
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    return PresetJSONParser(buffer.str()).parse();
+}
+
+int runSingle(const Options& options, const PlatformPreset& preset) {
+    std::fprintf(stderr, "luvlang-master: %s -> %s\n", options.inputFiles[0].c_str(), options.outputFile.c_str());
+    std::fprintf(stderr, "  Platform: %s (target %.1f LUFS, %.1f dBTP)\n",
+                 preset.platform.c_str(), preset.targetLUFS, preset.truePeak);
+
+    MasteringJobOptions jobOptions = options.job;
+    jobOptions.verbose = true;
+
+    std::optional<MasteringJob::Engine> engine;
+    MasteringJob job;
+    MasteringJobResult result = job.run(options.inputFiles[0], options.outputFile, preset, jobOptions, engine);
+    if (!result.success) {
+        std::fprintf(stderr, "luvlang-master: %s\n", result.error.c_str());
+        printJobResultJSON(stdout, result, preset);
+        return 1;
+    }
+
+    const double realtimeFactor = result.renderSeconds > 0.0 ? result.durationSeconds / result.renderSeconds : 0.0;
+    std::fprintf(stderr, "  Output: %.2f LUFS integrated, %.2f dBTP, LRA %.1f LU\n",
+                 result.integratedLUFS, result.truePeakDB, result.loudnessRange);
+    std::fprintf(stderr, "  Rendered %.1f s in %.3f s (%d pass%s): %.1fx realtime\n",
+                 result.durationSeconds, result.renderSeconds, result.passes,
+                 result.passes == 1 ? "" : "es", realtimeFactor);
+    printJobResultJSON(stdout, result, preset);
+    return 0;
+}
+
+// Output path for each input, in input order. Inputs sharing a file name
+// would have two workers writing one output, and an output that resolves
+// to an input would be truncated while it is still being read, so both
+// are rejected before anything is scheduled.
+std::vector<std::string> batchOutputPaths(const Options& options) {
+    namespace fs = std::filesystem;
+    std::set<fs::path> inputs;
+    for (const auto& input : options.inputFiles) inputs.insert(fs::weakly_canonical(input));
+
+    std::vector<std::string> outputs;
+    std::map<fs::path, std::string> claimed;  // Resolved output -> input writing it
+    for (const auto& input : options.inputFiles) {
+        const fs::path output = fs::path(options.batchDirectory) / fs::path(input).filename();
+        const fs::path resolved = fs::weakly_canonical(output);
+        if (inputs.count(resolved)) {
+            throw std::runtime_error(input + ": batch output " + output.string() + " would overwrite an input");
+        }
+        auto [it, inserted] = claimed.emplace(resolved, input);
+        if (!inserted) {
+            throw std::runtime_error(it->second + " and " + input + " map to the same batch output " + output.string());
+        }
+        outputs.push_back(output.string());
+    }
+    return outputs;
+}
+
+int runBatch(const Options& options, const PlatformPreset& preset) {
+    namespace fs = std::filesystem;
+    const std::vector<std::string> outputs = batchOutputPaths(options);
+    fs::create_directories(options.batchDirectory);
+
+    const size_t jobCount = options.inputFiles.size();
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    const int workers = std::min<int>(options.jobs > 0 ? options.jobs : hardware, static_cast<int>(jobCount));
+
+    // Largest files first so the longest render never starts last
+    std::vector<uintmax_t> sizes(jobCount, 0);
+    for (size_t i = 0; i < jobCount; ++i) {
+        std::error_code error;
+        uintmax_t size = fs::file_size(options.inputFiles[i], error);
+        sizes[i] = error ? 0 : size;
+    }
+    std::vector<size_t> order(jobCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+    std::fprintf(stderr, "luvlang-master: batch of %zu files -> %s (%d workers, %d I/O)\n",
+                 jobCount, options.batchDirectory.c_str(), workers, options.ioJobs);
+    std::fprintf(stderr, "  Platform: %s (target %.1f LUFS, %.1f dBTP)\n",
+                 preset.platform.c_str(), preset.targetLUFS, preset.truePeak);
+
+    // Per-worker engine and job buffers, reused across that worker's files
+    std::vector<std::optional<MasteringJob::Engine>> engines(workers);
+    std::vector<MasteringJob> renderers(workers);
+    std::vector<MasteringJobResult> results(jobCount);
+    std::mutex outputMutex;
+    IOGate io(options.ioJobs);
+
+    const auto start = std::chrono::steady_clock::now();
+    WorkStealingPool pool(workers);
+    pool.run(order, [&](int worker, size_t index) {
+        const std::string& input = options.inputFiles[index];
+        MasteringJobResult result = renderers[worker].run(input, outputs[index], preset, options.job, engines[worker], &io);
+        result.worker = worker;
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::fprintf(stderr, "  [%d] %s: %s\n", worker, fs::path(input).filename().string().c_str(),
+                     result.success ? "done" : result.error.c_str());
+        printJobResultJSON(stdout, result, preset);
+        std::fflush(stdout);
+        results[index] = std::move(result);
+    });
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t failed = 0;
+    double audioSeconds = 0.0;
+    double busySeconds = 0.0;
+    for (const auto& result : results) {
+        if (!result.success) ++failed;
+        audioSeconds += result.durationSeconds;
+        busySeconds += result.renderSeconds;
+    }
+    const double realtimeFactor = elapsed > 0.0 ? audioSeconds / elapsed : 0.0;
+    const double utilization = elapsed > 0.0 ? busySeconds / (elapsed * workers) : 0.0;
+
+    std::fprintf(stderr, "  Rendered %zu files (%.1f s audio) in %.3f s: %.1fx realtime, %.0f%% utilization, %zu steals\n",
+                 jobCount, audioSeconds, elapsed, realtimeFactor, 100.0 * utilization, pool.getStealCount());
+    std::printf("{\"success\": %s, \"batch\": true, \"files\": %zu, \"failed\": %zu, \"workers\": %d, "
+                "\"io_jobs\": %d, \"audio_seconds\": %.3f, \"wall_seconds\": %.3f, \"realtime_factor\": %.1f, "
+                "\"utilization\": %.3f, \"steals\": %zu}\n",
+                failed == 0 ? "true" : "false", jobCount, failed, workers, options.ioJobs,
+                audioSeconds, elapsed, realtimeFactor, utilization, pool.getStealCount());
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        Options options = parseArguments(argc, argv);
+
+        UserParams user;
+        if (!options.presetFile.empty()) user = loadPresetFile(options.presetFile);
+        user.merge(options.flags);
+
+        std::string platform = options.platform;
+        if (platform.empty()) {
+            auto it = user.strings.find("platform");
+            platform = (it != user.strings.end()) ? it->second : "spotify";
+        }
+        PlatformPreset preset = getPlatformPreset(platform, user);
+
+        return options.batchDirectory.empty() ? runSingle(options, preset) : runBatch(options, preset);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "luvlang-master: %s\n", e.what());
+        std::printf("{\"success\": false, \"error\": \"%s\"}\n", jsonEscape(e.what()).c_str());
+        return 1;
+    }
+}
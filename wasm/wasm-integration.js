@@ -10,6 +10,9 @@ class WASMMasteringIntegration {
         this.wasmModule = null;
         this.initialized = false;
         this.meteringCallback = null;
+        this.latencySamples = 0;  // Worklet input-to-output delay (bypass alignment)
+        this.streamOverruns = 0;  // Worklet ring glitches since initialization
+        this.streamUnderruns = 0;
 
         // AI Presets
         this.availablePresets = ['hip-hop', 'edm', 'pop', 'universal', 'classical', 'podcast'];
@@ -73,6 +76,7 @@ class WASMMasteringIntegration {
             case 'wasm_initialized':
                 if (data.success) {
                     console.log('   ✅ WASM engine initialized in AudioWorklet');
+                    this.latencySamples = data.latencySamples;
                     this.initializationComplete = true;
                 } else {
                     console.error('   ❌ WASM initialization failed:', data.error);
@@ -80,6 +84,16 @@ class WASMMasteringIntegration {
                 }
                 break;
 
+            case 'latency_changed':
+                this.latencySamples = data.latencySamples;
+                break;
+
+            case 'stream_xrun':
+                console.warn(`⚠️ Audio stream glitch: ${data.overruns} overruns, ${data.underruns} underruns`);
+                this.streamOverruns = data.overruns;
+                this.streamUnderruns = data.underruns;
+                break;
+
             case 'metering_update':
                 if (this.meteringCallback) {
                     this.meteringCallback(data);
@@ -208,6 +222,42 @@ class WASMMasteringIntegration {
         });
     }
 
+    /**
+     * Set limiter look-ahead (also its attack time). Changes the latency;
+     * the worklet answers with a 'latency_changed' message.
+     * @param {number} ms - Look-ahead in ms (0 to 50)
+     */
+    setLimiterLookAhead(ms) {
+        if (!this.initialized) return;
+
+        this.workletNode.port.postMessage({
+            type: 'set_limiter_lookahead',
+            data: { ms }
+        });
+    }
+
+    /**
+     * Half-band IIR true-peak oversampling for live monitoring (a few
+     * samples of delay instead of 16). Changes the latency.
+     * @param {boolean} enabled
+     */
+    setLowLatencyOversampling(enabled) {
+        if (!this.initialized) return;
+
+        this.workletNode.port.postMessage({
+            type: 'set_low_latency_oversampling',
+            data: { enabled }
+        });
+    }
+
+    /**
+     * Samples between worklet input and output, for aligning the dry
+     * signal on A/B bypass. Updated on every 'latency_changed' message.
+     */
+    getLatencySamples() {
+        return this.latencySamples;
+    }
+
     /**
      * Load AI preset
      * @param {string} presetName - 'hip-hop', 'edm', 'pop', 'universal', 'classical', 'podcast'
@@ -252,7 +302,11 @@ class WASMMasteringIntegration {
      *   integratedLUFS: number,
      *   shortTermLUFS: number,
      *   momentaryLUFS: number,
+     *   loudnessRange: number (LU),
+     *   truePeakDB: number (dBTP),
+     *   crestFactor: number (dB),
      *   phaseCorrelation: number (-1 to +1),
+     *   deEsserGainReduction: number (dB),
      *   limiterGainReduction: number (dB)
      * }
      */